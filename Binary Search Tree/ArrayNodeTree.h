@@ -0,0 +1,317 @@
+#ifndef ARRAY_NODE_TREE_
+#define ARRAY_NODE_TREE_
+
+#include "BinaryTreeInterface.h"
+#include "PrecondViolatedExcept.h"
+#include "NotFoundException.h"
+#include "TraversalStack.h"
+
+using namespace std;
+
+// Array-backed storage for the level-filled shape kept by BinaryNodeTree (see the examples in TopicD.cpp).
+// The items sit in one vector in insertion order, so entry i holds position i + 1 of the shape and no node
+// or link is allocated. The children follow from the position alone :
+// + The root (1) has the children 2 and 3.
+// + An even position p (left side) has the children 2p and 2p + 2.
+// + An odd position p > 1 (right side) has the children 2p - 1 and 2p + 1.
+// Every traversal visits the items in the same order as BinaryNodeTree.
+template<class ItemType>
+class ArrayNodeTree : public BinaryTreeInterface<ItemType>
+{
+private:
+	vector<ItemType> items;
+
+protected:
+	//------------------------------------------------------------
+	// Protected Utility Methods Section:
+	// Position arithmetic and recursive helper methods for the public methods.
+	//------------------------------------------------------------
+	static int leftChildPosition(int position);
+	static int rightChildPosition(int position);
+
+	// Returns the index of the first entry in preorder that is equal to target (item == target), or -1 if there
+	// is none. BinaryNodeTree::findNode searches in the same order, so with equal or wildcard-matching items
+	// both trees pick the same entry.
+	int findIndex(const ItemType& target) const;
+
+	// Recursive traversal helper methods, starting at the given position.
+	void preorder(void visit(ItemType&), int position) const;
+	void inorder(void visit(ItemType&), int position) const;
+	void postorder(void visit(ItemType&), int position) const;
+
+public:
+	//------------------------------------------------------------
+	// Constructor and Destructor Section.
+	//------------------------------------------------------------
+	ArrayNodeTree();
+	ArrayNodeTree(const ItemType& rootItem);
+
+	//------------------------------------------------------------
+	// Public BinaryTreeInterface Methods Section.
+	//------------------------------------------------------------
+	bool isEmpty() const;
+	int getHeight() const;
+	int getNumberOfNodes() const;
+
+	ItemType getRootData() const throw(PrecondViolatedExcept);
+	void setRootData(const ItemType& newData) throw(PrecondViolatedExcept);
+
+	bool add(const ItemType& newData); // Appends an item : the next free slot is always the end of the array
+	bool remove(const ItemType& data); // The last item takes the place of the removed one
+	void clear();
+
+	ItemType getEntry(const ItemType& anEntry) const throw(NotFoundException);
+	bool contains(const ItemType& anEntry) const;
+
+	// Reserves room for the given number of items.
+	void reserve(int itemCount);
+
+	//------------------------------------------------------------
+	// Public Traversals Section.
+	//------------------------------------------------------------
+	void preorderTraverse(void visit(ItemType&)) const;
+	void inorderTraverse(void visit(ItemType&)) const;
+	void postorderTraverse(void visit(ItemType&)) const;
+	void generalOrderTraverse(void visit(ItemType&)) const; // The original order of the data : a scan of the array
+	void linearOrderTraverse(void visit(ItemType&)) const;    // Level by level : one pass over the array
+
+}; // end ArrayNodeTree
+
+   // -------------------Definitons----------------------------
+template<class ItemType>
+ArrayNodeTree<ItemType>::ArrayNodeTree() {}
+
+template<class ItemType>
+ArrayNodeTree<ItemType>::ArrayNodeTree(const ItemType& rootItem)
+{
+	add(rootItem);
+}
+
+template<class ItemType>
+int ArrayNodeTree<ItemType>::leftChildPosition(int position)
+{
+	if (position == 1) return 2;
+	return (position % 2 == 0) ? 2 * position : 2 * position - 1;
+}
+
+template<class ItemType>
+int ArrayNodeTree<ItemType>::rightChildPosition(int position)
+{
+	if (position == 1) return 3;
+	return (position % 2 == 0) ? 2 * position + 2 : 2 * position + 1;
+}
+
+template<class ItemType>
+int ArrayNodeTree<ItemType>::findIndex(const ItemType& target) const
+{
+	int nodeCount = (int)items.size();
+	SmallStack<int> pendingPositions;
+	if (nodeCount > 0) pendingPositions.push(1);
+
+	while (!pendingPositions.isEmpty())
+	{
+		int position = pendingPositions.peek();
+		pendingPositions.pop();
+
+		if (items[position - 1] == target) return position - 1;
+
+		// Right first, so that the left subtree is searched first
+		int rightPosition = rightChildPosition(position);
+		int leftPosition = leftChildPosition(position);
+		if (rightPosition <= nodeCount) pendingPositions.push(rightPosition);
+		if (leftPosition <= nodeCount) pendingPositions.push(leftPosition);
+	}
+
+	return -1;
+}
+
+template<class ItemType>
+bool ArrayNodeTree<ItemType>::isEmpty() const
+{
+	return items.empty();
+}
+
+template<class ItemType>
+int ArrayNodeTree<ItemType>::getHeight() const
+{
+	int nodeCount = (int)items.size();
+	if (nodeCount <= 1) return nodeCount;
+
+	// The left side holds the even positions and is never shorter than the right side.
+	// It is itself level-filled, so its height is one more than the highest bit of its size.
+	int leftCount = nodeCount / 2;
+	int height = 2;
+	while ((leftCount >>= 1) != 0) height++;
+
+	return height;
+}
+
+template<class ItemType>
+int ArrayNodeTree<ItemType>::getNumberOfNodes() const
+{
+	return (int)items.size();
+}
+
+template<class ItemType>
+ItemType ArrayNodeTree<ItemType>::getRootData() const throw(PrecondViolatedExcept)
+{
+	if (!items.empty())
+	{
+		return items[0];
+	}
+
+	throw PrecondViolatedExcept("ArrayNodeTree::getRootData() : The tree is empty");
+}
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::setRootData(const ItemType& newData) throw(PrecondViolatedExcept)
+{
+	if (!items.empty())
+	{
+		items[0] = newData;
+		return;
+	}
+
+	throw PrecondViolatedExcept("ArrayNodeTree::setRootData() : The tree is empty");
+}
+
+template<class ItemType>
+bool ArrayNodeTree<ItemType>::add(const ItemType& newData)
+{
+	items.push_back(newData);
+	return true;
+} // end add
+
+template<class ItemType>
+bool ArrayNodeTree<ItemType>::remove(const ItemType& target)
+{
+	int targetIndex = findIndex(target);
+	if (targetIndex < 0) return false;
+
+	// Same as BinaryNodeTree : the last item fills the hole, so the shape stays level-filled
+	if (targetIndex != (int)items.size() - 1)
+		items[targetIndex] = std::move(items.back());
+
+	items.pop_back();
+	return true;
+} // end remove
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::clear()
+{
+	vector<ItemType>().swap(items);
+}
+
+template<class ItemType>
+ItemType ArrayNodeTree<ItemType>::getEntry(const ItemType& anEntry) const throw(NotFoundException)
+{
+	int entryIndex = findIndex(anEntry);
+
+	if (entryIndex >= 0) return items[entryIndex];
+	throw NotFoundException("ArrayNodeTree::getEntry : Entry not found");
+}
+
+template<class ItemType>
+bool ArrayNodeTree<ItemType>::contains(const ItemType& anEntry) const
+{
+	return (findIndex(anEntry) >= 0);
+}
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::reserve(int itemCount)
+{
+	items.reserve(itemCount);
+}
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::preorder(void visit(ItemType&), int position) const
+{
+	if (position <= (int)items.size())
+	{
+		ItemType theItem = items[position - 1];
+		visit(theItem);
+		preorder(visit, leftChildPosition(position));
+		preorder(visit, rightChildPosition(position));
+	} // End If-statement
+} // End preorder()
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::inorder(void visit(ItemType&), int position) const
+{
+	if (position <= (int)items.size())
+	{
+		inorder(visit, leftChildPosition(position));
+		ItemType theItem = items[position - 1];
+		visit(theItem);
+		inorder(visit, rightChildPosition(position));
+	} // End If-statement
+} // End inorder()
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::postorder(void visit(ItemType&), int position) const
+{
+	if (position <= (int)items.size())
+	{
+		postorder(visit, leftChildPosition(position));
+		postorder(visit, rightChildPosition(position));
+		ItemType theItem = items[position - 1];
+		visit(theItem);
+	} // End If-statement
+} // End postorder()
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::preorderTraverse(void visit(ItemType&)) const
+{
+	preorder(visit, 1);
+}
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::inorderTraverse(void visit(ItemType&)) const
+{
+	inorder(visit, 1);
+}
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::postorderTraverse(void visit(ItemType&)) const
+{
+	postorder(visit, 1);
+}
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::generalOrderTraverse(void visit(ItemType&)) const
+{
+	for (int i = 0; i < (int)items.size(); i++)
+	{
+		ItemType theItem = items[i];
+		visit(theItem);
+	}
+} // End generalOrderTraverse()
+
+template<class ItemType>
+void ArrayNodeTree<ItemType>::linearOrderTraverse(void visit(ItemType&)) const
+{
+	int nodeCount = (int)items.size();
+	if (nodeCount == 0) return;
+
+	ItemType rootItem = items[0];
+	visit(rootItem);
+
+	// Entries [first, 2 * first) of each side make up one level : the left side sits at the even
+	// positions 2k and comes first, then the right side at the odd positions 2k + 1.
+	for (int first = 1; 2 * first <= nodeCount; first *= 2)
+	{
+		for (int k = first; k < 2 * first && 2 * k <= nodeCount; k++)
+		{
+			ItemType theItem = items[2 * k - 1];
+			visit(theItem);
+		}
+
+		for (int k = first; k < 2 * first && 2 * k + 1 <= nodeCount; k++)
+		{
+			ItemType theItem = items[2 * k];
+			visit(theItem);
+		}
+	}
+} // End linearOrderTraverse()
+
+#endif
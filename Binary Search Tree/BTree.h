@@ -0,0 +1,732 @@
+#ifndef B_TREE_
+#define B_TREE_
+
+#include "BinaryTreeInterface.h"
+#include "PrecondViolatedExcept.h"
+#include "NotFoundException.h"
+
+#if defined(__AVX2__)
+#define BTREE_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BTREE_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+// Minimum degree whose key block fills a 64-byte cache line (a node holds up to 2 * degree - 1 keys) : 15 keys
+// for int. Only the keys are sized to the line : the child pointers and counts follow them, so a whole int node
+// is about 200 bytes, and a lookup reads the key block and one child pointer of each node on its path.
+// Only int keys are compared with SIMD, with AVX2 or SSE2 when the compiler targets them (BTREE_AVX2 and
+// BTREE_SSE2 above); other key types, and builds without either, search the key block one key at a time.
+// Large items fall back to a 2-3-4 tree.
+template<class ItemType>
+struct BTreeDefaultDegree
+{
+	static const int value = ((64 / sizeof(ItemType) + 1) / 2 < 2) ? 2 : (int)((64 / sizeof(ItemType) + 1) / 2);
+};
+
+// Searches the sorted keys of one node.
+template<class ItemType>
+struct BTreeKeySearch
+{
+	// Returns the number of keys less than target.
+	static int lowerBound(const ItemType* keys, int keyCount, const ItemType& target)
+	{
+		int i = 0;
+		while (i < keyCount && keys[i] < target) i++;
+		return i;
+	}
+
+	// Returns the number of keys not greater than target.
+	static int upperBound(const ItemType* keys, int keyCount, const ItemType& target)
+	{
+		int i = 0;
+		while (i < keyCount && !(target < keys[i])) i++;
+		return i;
+	}
+};
+
+// int keys are compared several at a time : each compare yields a lane mask, and since the keys are sorted
+// the mask is a run of ones followed by zeros, so the first lane that fails ends the search.
+template<>
+struct BTreeKeySearch<int>
+{
+	static int countLowOnes(int mask)
+	{
+		int count = 0;
+		while (mask & 1) { count++; mask >>= 1; }
+		return count;
+	}
+
+	static int lowerBound(const int* keys, int keyCount, const int& target)
+	{
+		int i = 0;
+#if defined(BTREE_AVX2)
+		__m256i target8 = _mm256_set1_epi32(target);
+		for (; i + 8 <= keyCount; i += 8)
+		{
+			__m256i keys8 = _mm256_loadu_si256((const __m256i*)(keys + i));
+			int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(target8, keys8)));
+			if (mask != 0xFF) return i + countLowOnes(mask);
+		}
+#endif
+#if defined(BTREE_SSE2)
+		__m128i target4 = _mm_set1_epi32(target);
+		for (; i + 4 <= keyCount; i += 4)
+		{
+			__m128i keys4 = _mm_loadu_si128((const __m128i*)(keys + i));
+			int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(target4, keys4)));
+			if (mask != 0xF) return i + countLowOnes(mask);
+		}
+#endif
+		while (i < keyCount && keys[i] < target) i++;
+		return i;
+	}
+
+	static int upperBound(const int* keys, int keyCount, const int& target)
+	{
+		int i = 0;
+#if defined(BTREE_AVX2)
+		__m256i target8 = _mm256_set1_epi32(target);
+		for (; i + 8 <= keyCount; i += 8)
+		{
+			__m256i keys8 = _mm256_loadu_si256((const __m256i*)(keys + i));
+			int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(keys8, target8)));
+			if (mask != 0) return i + countLowOnes(~mask);
+		}
+#endif
+#if defined(BTREE_SSE2)
+		__m128i target4 = _mm_set1_epi32(target);
+		for (; i + 4 <= keyCount; i += 4)
+		{
+			__m128i keys4 = _mm_loadu_si128((const __m128i*)(keys + i));
+			int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(keys4, target4)));
+			if (mask != 0) return i + countLowOnes(~mask);
+		}
+#endif
+		while (i < keyCount && !(target < keys[i])) i++;
+		return i;
+	}
+};
+
+// B-tree of the given minimum degree : every node but the root holds between MinDegree - 1 and 2 * MinDegree - 1
+// sorted keys, and every leaf sits at the same depth. The keys of a node sit side by side, so a lookup costs
+// one node per level instead of one node per comparison.
+// Entries are compared with operator<, and equal entries are kept, as in BinarySearchTree.
+template<class ItemType, int MinDegree = BTreeDefaultDegree<ItemType>::value>
+class BTree : public BinaryTreeInterface<ItemType>
+{
+private:
+	static const int maxKeys = 2 * MinDegree - 1;
+
+	// The keys come first and are the only part scanned by a search (see BTreeDefaultDegree).
+	struct Node
+	{
+		ItemType keys[maxKeys];
+		Node* children[maxKeys + 1];
+		int keyCount;
+		bool isLeaf;
+
+		Node(bool leaf) : keyCount(0), isLeaf(leaf) {}
+	};
+
+	Node* rootPtr;
+	int entryCount;
+
+protected:
+	//------------------------------------------------------------
+	// Protected Utility Methods Section:
+	// Recursive helper methods for the public methods.
+	//------------------------------------------------------------
+	static Node* copyTree(const Node* nodePtr);
+	static void destroyTree(Node* nodePtr);
+
+	// Splits the full child at the given index around its middle key, which moves up into nodePtr.
+	static void splitChild(Node* nodePtr, int index);
+
+	// Adds newEntry to the subtree rooted at nodePtr, which is not full.
+	static void addNonFull(Node* nodePtr, const ItemType& newEntry);
+
+	// Removes one entry equal to target from the subtree rooted at nodePtr.
+	// @pre  nodePtr is the root or holds at least MinDegree keys.
+	static bool removeFrom(Node* nodePtr, const ItemType& target);
+
+	// Gives the child at the given index at least MinDegree keys, by borrowing from a sibling or merging with one.
+	// Returns the index of the child that now covers the same keys.
+	static int fillChild(Node* nodePtr, int index);
+	static void borrowFromLeft(Node* nodePtr, int index);
+	static void borrowFromRight(Node* nodePtr, int index);
+	static void mergeChildren(Node* nodePtr, int index);
+
+	// Returns the stored entry equal to target, or nullptr if there is none.
+	const ItemType* findEntry(const ItemType& target) const;
+
+	// Recursive traversal helper methods:
+	static void preorder(void visit(ItemType&), const Node* nodePtr);
+	static void inorder(void visit(ItemType&), const Node* nodePtr);
+	static void postorder(void visit(ItemType&), const Node* nodePtr);
+
+public:
+	//------------------------------------------------------------
+	// Constructor and Destructor Section.
+	//------------------------------------------------------------
+	BTree();
+	BTree(const ItemType& rootItem);
+	BTree(const BTree<ItemType, MinDegree>& tree);
+	virtual ~BTree();
+
+	//------------------------------------------------------------
+	// Public BinaryTreeInterface Methods Section.
+	//------------------------------------------------------------
+	bool isEmpty() const;
+	int getHeight() const;        // Levels of nodes
+	int getNumberOfNodes() const; // Entries, as for BinarySearchTree
+
+	ItemType getRootData() const throw(PrecondViolatedExcept); // The first key of the root node
+
+	// Replaces the first key of the root node by removing it and adding newData, so the order is kept.
+	void setRootData(const ItemType& newData);
+
+	bool add(const ItemType& newData);
+	bool remove(const ItemType& data);
+	void clear();
+
+	ItemType getEntry(const ItemType& anEntry) const throw(NotFoundException);
+	bool contains(const ItemType& anEntry) const;
+
+	//------------------------------------------------------------
+	// Public Traversals Section.
+	//------------------------------------------------------------
+	void preorderTraverse(void visit(ItemType&)) const;     // The keys of a node, then its children
+	void inorderTraverse(void visit(ItemType&)) const;      // Sorted order
+	void postorderTraverse(void visit(ItemType&)) const;    // The children of a node, then its keys
+	void generalOrderTraverse(void visit(ItemType&)) const; // No insertion order is kept : sorted order
+	void linearOrderTraverse(void visit(ItemType&)) const;  // Node by node, level by level
+
+	//------------------------------------------------------------
+	// Overloaded Operator Section.
+	//------------------------------------------------------------
+	BTree<ItemType, MinDegree>& operator=(const BTree<ItemType, MinDegree>& rightHandSide);
+}; // end BTree
+
+   // -------------------Definitons----------------------------
+template<class ItemType, int MinDegree>
+BTree<ItemType, MinDegree>::BTree() : rootPtr(nullptr), entryCount(0) {}
+
+template<class ItemType, int MinDegree>
+BTree<ItemType, MinDegree>::BTree(const ItemType& rootItem) : rootPtr(nullptr), entryCount(0)
+{
+	add(rootItem);
+}
+
+template<class ItemType, int MinDegree>
+BTree<ItemType, MinDegree>::BTree(const BTree<ItemType, MinDegree>& tree) : rootPtr(copyTree(tree.rootPtr)), entryCount(tree.entryCount) {}
+
+template<class ItemType, int MinDegree>
+BTree<ItemType, MinDegree>::~BTree()
+{
+	destroyTree(rootPtr);
+}
+
+template<class ItemType, int MinDegree>
+BTree<ItemType, MinDegree>& BTree<ItemType, MinDegree>::operator=(const BTree<ItemType, MinDegree>& rightHandSide)
+{
+	if (&rightHandSide != this)
+	{
+		Node* newRootPtr = copyTree(rightHandSide.rootPtr);
+		destroyTree(rootPtr);
+		rootPtr = newRootPtr;
+		entryCount = rightHandSide.entryCount;
+	}
+
+	return (*this);
+}
+
+template<class ItemType, int MinDegree>
+typename BTree<ItemType, MinDegree>::Node* BTree<ItemType, MinDegree>::copyTree(const Node* nodePtr)
+{
+	if (nodePtr == nullptr) return nullptr;
+
+	Node* newNodePtr = new Node(nodePtr->isLeaf);
+	newNodePtr->keyCount = nodePtr->keyCount;
+
+	for (int i = 0; i < nodePtr->keyCount; i++)
+		newNodePtr->keys[i] = nodePtr->keys[i];
+
+	if (!nodePtr->isLeaf)
+	{
+		for (int i = 0; i <= nodePtr->keyCount; i++)
+			newNodePtr->children[i] = copyTree(nodePtr->children[i]);
+	}
+
+	return newNodePtr;
+}
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::destroyTree(Node* nodePtr)
+{
+	if (nodePtr == nullptr) return;
+
+	// Every leaf is at the same depth, which stays logarithmic, so the recursion is shallow
+	if (!nodePtr->isLeaf)
+	{
+		for (int i = 0; i <= nodePtr->keyCount; i++)
+			destroyTree(nodePtr->children[i]);
+	}
+
+	delete nodePtr;
+}
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::splitChild(Node* nodePtr, int index)
+{
+	Node* fullPtr = nodePtr->children[index];
+	Node* newPtr = new Node(fullPtr->isLeaf);
+
+	// The upper MinDegree - 1 keys (and MinDegree children) move to the new node
+	newPtr->keyCount = MinDegree - 1;
+	for (int i = 0; i < MinDegree - 1; i++)
+		newPtr->keys[i] = fullPtr->keys[i + MinDegree];
+
+	if (!fullPtr->isLeaf)
+	{
+		for (int i = 0; i < MinDegree; i++)
+			newPtr->children[i] = fullPtr->children[i + MinDegree];
+	}
+
+	fullPtr->keyCount = MinDegree - 1;
+
+	// The middle key moves up, between the two halves
+	for (int i = nodePtr->keyCount; i > index; i--)
+	{
+		nodePtr->keys[i] = nodePtr->keys[i - 1];
+		nodePtr->children[i + 1] = nodePtr->children[i];
+	}
+
+	nodePtr->keys[index] = fullPtr->keys[MinDegree - 1];
+	nodePtr->children[index + 1] = newPtr;
+	nodePtr->keyCount++;
+} // End splitChild()
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::addNonFull(Node* nodePtr, const ItemType& newEntry)
+{
+	while (!nodePtr->isLeaf)
+	{
+		// Equal entries go to the right, after the existing ones
+		int index = BTreeKeySearch<ItemType>::upperBound(nodePtr->keys, nodePtr->keyCount, newEntry);
+
+		if (nodePtr->children[index]->keyCount == maxKeys)
+		{
+			splitChild(nodePtr, index);
+			if (!(newEntry < nodePtr->keys[index])) index++;
+		}
+
+		nodePtr = nodePtr->children[index];
+	}
+
+	int index = BTreeKeySearch<ItemType>::upperBound(nodePtr->keys, nodePtr->keyCount, newEntry);
+
+	for (int i = nodePtr->keyCount; i > index; i--)
+		nodePtr->keys[i] = nodePtr->keys[i - 1];
+
+	nodePtr->keys[index] = newEntry;
+	nodePtr->keyCount++;
+} // End addNonFull()
+
+template<class ItemType, int MinDegree>
+bool BTree<ItemType, MinDegree>::removeFrom(Node* nodePtr, const ItemType& target)
+{
+	int index = BTreeKeySearch<ItemType>::lowerBound(nodePtr->keys, nodePtr->keyCount, target);
+
+	if (index < nodePtr->keyCount && !(target < nodePtr->keys[index]))
+	{
+		if (nodePtr->isLeaf)
+		{
+			for (int i = index; i < nodePtr->keyCount - 1; i++)
+				nodePtr->keys[i] = nodePtr->keys[i + 1];
+
+			nodePtr->keyCount--;
+			return true;
+		}
+
+		Node* leftPtr = nodePtr->children[index];
+		Node* rightPtr = nodePtr->children[index + 1];
+
+		if (leftPtr->keyCount >= MinDegree)
+		{
+			// The inorder predecessor takes the place of the removed entry
+			const Node* currentPtr = leftPtr;
+			while (!currentPtr->isLeaf) currentPtr = currentPtr->children[currentPtr->keyCount];
+
+			ItemType predecessor = currentPtr->keys[currentPtr->keyCount - 1];
+			nodePtr->keys[index] = predecessor;
+			return removeFrom(leftPtr, predecessor);
+		}
+
+		if (rightPtr->keyCount >= MinDegree)
+		{
+			// The inorder successor takes the place of the removed entry
+			const Node* currentPtr = rightPtr;
+			while (!currentPtr->isLeaf) currentPtr = currentPtr->children[0];
+
+			ItemType successor = currentPtr->keys[0];
+			nodePtr->keys[index] = successor;
+			return removeFrom(rightPtr, successor);
+		}
+
+		// Both neighbours are minimal : the entry moves down between them and is removed from the merged node
+		mergeChildren(nodePtr, index);
+		return removeFrom(leftPtr, target);
+	}
+
+	if (nodePtr->isLeaf) return false;
+
+	// The target can only be in the child at index, which must be able to lose a key
+	if (nodePtr->children[index]->keyCount < MinDegree)
+		index = fillChild(nodePtr, index);
+
+	return removeFrom(nodePtr->children[index], target);
+} // End removeFrom()
+
+template<class ItemType, int MinDegree>
+int BTree<ItemType, MinDegree>::fillChild(Node* nodePtr, int index)
+{
+	if (index > 0 && nodePtr->children[index - 1]->keyCount >= MinDegree)
+	{
+		borrowFromLeft(nodePtr, index);
+		return index;
+	}
+
+	if (index < nodePtr->keyCount && nodePtr->children[index + 1]->keyCount >= MinDegree)
+	{
+		borrowFromRight(nodePtr, index);
+		return index;
+	}
+
+	if (index < nodePtr->keyCount)
+	{
+		mergeChildren(nodePtr, index);
+		return index;
+	}
+
+	mergeChildren(nodePtr, index - 1);
+	return index - 1;
+} // End fillChild()
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::borrowFromLeft(Node* nodePtr, int index)
+{
+	Node* childPtr = nodePtr->children[index];
+	Node* siblingPtr = nodePtr->children[index - 1];
+
+	for (int i = childPtr->keyCount; i > 0; i--)
+		childPtr->keys[i] = childPtr->keys[i - 1];
+
+	if (!childPtr->isLeaf)
+	{
+		for (int i = childPtr->keyCount + 1; i > 0; i--)
+			childPtr->children[i] = childPtr->children[i - 1];
+
+		childPtr->children[0] = siblingPtr->children[siblingPtr->keyCount];
+	}
+
+	// The separator moves down and the sibling's last key replaces it
+	childPtr->keys[0] = nodePtr->keys[index - 1];
+	nodePtr->keys[index - 1] = siblingPtr->keys[siblingPtr->keyCount - 1];
+
+	childPtr->keyCount++;
+	siblingPtr->keyCount--;
+} // End borrowFromLeft()
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::borrowFromRight(Node* nodePtr, int index)
+{
+	Node* childPtr = nodePtr->children[index];
+	Node* siblingPtr = nodePtr->children[index + 1];
+
+	// The separator moves down and the sibling's first key replaces it
+	childPtr->keys[childPtr->keyCount] = nodePtr->keys[index];
+	if (!childPtr->isLeaf)
+		childPtr->children[childPtr->keyCount + 1] = siblingPtr->children[0];
+
+	nodePtr->keys[index] = siblingPtr->keys[0];
+
+	for (int i = 0; i < siblingPtr->keyCount - 1; i++)
+		siblingPtr->keys[i] = siblingPtr->keys[i + 1];
+
+	if (!siblingPtr->isLeaf)
+	{
+		for (int i = 0; i < siblingPtr->keyCount; i++)
+			siblingPtr->children[i] = siblingPtr->children[i + 1];
+	}
+
+	childPtr->keyCount++;
+	siblingPtr->keyCount--;
+} // End borrowFromRight()
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::mergeChildren(Node* nodePtr, int index)
+{
+	Node* leftPtr = nodePtr->children[index];
+	Node* rightPtr = nodePtr->children[index + 1];
+
+	// The separator and the right child's keys are appended to the left child
+	leftPtr->keys[leftPtr->keyCount] = nodePtr->keys[index];
+
+	for (int i = 0; i < rightPtr->keyCount; i++)
+		leftPtr->keys[leftPtr->keyCount + 1 + i] = rightPtr->keys[i];
+
+	if (!leftPtr->isLeaf)
+	{
+		for (int i = 0; i <= rightPtr->keyCount; i++)
+			leftPtr->children[leftPtr->keyCount + 1 + i] = rightPtr->children[i];
+	}
+
+	leftPtr->keyCount += rightPtr->keyCount + 1;
+
+	for (int i = index; i < nodePtr->keyCount - 1; i++)
+	{
+		nodePtr->keys[i] = nodePtr->keys[i + 1];
+		nodePtr->children[i + 1] = nodePtr->children[i + 2];
+	}
+
+	nodePtr->keyCount--;
+	delete rightPtr;
+} // End mergeChildren()
+
+template<class ItemType, int MinDegree>
+const ItemType* BTree<ItemType, MinDegree>::findEntry(const ItemType& target) const
+{
+	const Node* nodePtr = rootPtr;
+
+	while (nodePtr != nullptr)
+	{
+		int index = BTreeKeySearch<ItemType>::lowerBound(nodePtr->keys, nodePtr->keyCount, target);
+
+		if (index < nodePtr->keyCount && !(target < nodePtr->keys[index]))
+			return &nodePtr->keys[index];
+
+		nodePtr = nodePtr->isLeaf ? nullptr : nodePtr->children[index];
+	}
+
+	return nullptr;
+} // End findEntry()
+
+template<class ItemType, int MinDegree>
+bool BTree<ItemType, MinDegree>::isEmpty() const
+{
+	return (entryCount == 0);
+}
+
+template<class ItemType, int MinDegree>
+int BTree<ItemType, MinDegree>::getHeight() const
+{
+	int height = 0;
+
+	for (const Node* nodePtr = rootPtr; nodePtr != nullptr; nodePtr = nodePtr->isLeaf ? nullptr : nodePtr->children[0])
+		height++;
+
+	return height;
+}
+
+template<class ItemType, int MinDegree>
+int BTree<ItemType, MinDegree>::getNumberOfNodes() const
+{
+	return entryCount;
+}
+
+template<class ItemType, int MinDegree>
+ItemType BTree<ItemType, MinDegree>::getRootData() const throw(PrecondViolatedExcept)
+{
+	if (rootPtr != nullptr)
+	{
+		return rootPtr->keys[0];
+	}
+
+	throw PrecondViolatedExcept("BTree::getRootData() : The tree is empty");
+}
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::setRootData(const ItemType& newData)
+{
+	if (rootPtr != nullptr)
+	{
+		ItemType oldData = rootPtr->keys[0];
+		remove(oldData);
+	}
+
+	add(newData);
+}
+
+template<class ItemType, int MinDegree>
+bool BTree<ItemType, MinDegree>::add(const ItemType& newData)
+{
+	if (rootPtr == nullptr)
+	{
+		rootPtr = new Node(true);
+	}
+	else if (rootPtr->keyCount == maxKeys)
+	{
+		// The tree grows at the root : a full root is split under a new one
+		Node* newRootPtr = new Node(false);
+		newRootPtr->children[0] = rootPtr;
+		rootPtr = newRootPtr;
+		splitChild(rootPtr, 0);
+	}
+
+	addNonFull(rootPtr, newData);
+	entryCount++;
+
+	return true;
+} // end add
+
+template<class ItemType, int MinDegree>
+bool BTree<ItemType, MinDegree>::remove(const ItemType& target)
+{
+	if (rootPtr == nullptr) return false;
+
+	bool isSuccessful = removeFrom(rootPtr, target);
+
+	// The tree shrinks at the root : an empty root hands over to its only child
+	if (rootPtr->keyCount == 0)
+	{
+		Node* oldRootPtr = rootPtr;
+		rootPtr = rootPtr->isLeaf ? nullptr : rootPtr->children[0];
+		delete oldRootPtr;
+	}
+
+	if (isSuccessful) entryCount--;
+	return isSuccessful;
+} // end remove
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::clear()
+{
+	destroyTree(rootPtr);
+	rootPtr = nullptr;
+	entryCount = 0;
+}
+
+template<class ItemType, int MinDegree>
+ItemType BTree<ItemType, MinDegree>::getEntry(const ItemType& anEntry) const throw(NotFoundException)
+{
+	const ItemType* entryPtr = findEntry(anEntry);
+
+	if (entryPtr != nullptr) return *entryPtr;
+	throw NotFoundException("BTree::getEntry : Entry not found");
+}
+
+template<class ItemType, int MinDegree>
+bool BTree<ItemType, MinDegree>::contains(const ItemType& anEntry) const
+{
+	return (findEntry(anEntry) != nullptr);
+}
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::preorder(void visit(ItemType&), const Node* nodePtr)
+{
+	for (int i = 0; i < nodePtr->keyCount; i++)
+	{
+		ItemType theItem = nodePtr->keys[i];
+		visit(theItem);
+	}
+
+	if (!nodePtr->isLeaf)
+	{
+		for (int i = 0; i <= nodePtr->keyCount; i++)
+			preorder(visit, nodePtr->children[i]);
+	}
+} // End preorder()
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::inorder(void visit(ItemType&), const Node* nodePtr)
+{
+	for (int i = 0; i < nodePtr->keyCount; i++)
+	{
+		if (!nodePtr->isLeaf) inorder(visit, nodePtr->children[i]);
+
+		ItemType theItem = nodePtr->keys[i];
+		visit(theItem);
+	}
+
+	if (!nodePtr->isLeaf) inorder(visit, nodePtr->children[nodePtr->keyCount]);
+} // End inorder()
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::postorder(void visit(ItemType&), const Node* nodePtr)
+{
+	if (!nodePtr->isLeaf)
+	{
+		for (int i = 0; i <= nodePtr->keyCount; i++)
+			postorder(visit, nodePtr->children[i]);
+	}
+
+	for (int i = 0; i < nodePtr->keyCount; i++)
+	{
+		ItemType theItem = nodePtr->keys[i];
+		visit(theItem);
+	}
+} // End postorder()
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::preorderTraverse(void visit(ItemType&)) const
+{
+	if (rootPtr != nullptr) preorder(visit, rootPtr);
+}
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::inorderTraverse(void visit(ItemType&)) const
+{
+	if (rootPtr != nullptr) inorder(visit, rootPtr);
+}
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::postorderTraverse(void visit(ItemType&)) const
+{
+	if (rootPtr != nullptr) postorder(visit, rootPtr);
+}
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::generalOrderTraverse(void visit(ItemType&)) const
+{
+	inorderTraverse(visit);
+}
+
+template<class ItemType, int MinDegree>
+void BTree<ItemType, MinDegree>::linearOrderTraverse(void visit(ItemType&)) const
+{
+	if (rootPtr == nullptr) return;
+
+	vector<const Node*> levelNodes(1, rootPtr);
+
+	while (!levelNodes.empty())
+	{
+		vector<const Node*> nextLevelNodes;
+
+		for (int i = 0; i < (int)levelNodes.size(); i++)
+		{
+			const Node* nodePtr = levelNodes[i];
+
+			for (int j = 0; j < nodePtr->keyCount; j++)
+			{
+				ItemType theItem = nodePtr->keys[j];
+				visit(theItem);
+			}
+
+			if (!nodePtr->isLeaf)
+			{
+				for (int j = 0; j <= nodePtr->keyCount; j++)
+					nextLevelNodes.push_back(nodePtr->children[j]);
+			}
+		}
+
+		levelNodes.swap(nextLevelNodes);
+	}
+} // End linearOrderTraverse()
+
+#endif
@@ -0,0 +1,421 @@
+#ifndef BALANCE_POLICIES_
+#define BALANCE_POLICIES_
+
+#include "General.h"
+#include "BinaryNode.h"
+#include <random>
+#include <climits>
+
+// Balancing policies for BinarySearchTree<ItemType, BalancePolicy>.
+// BinarySearchTree keeps one policy object per tree and calls these hooks :
+//   initNode(node)            - Before a new node is placed.
+//   rebalance(subTreePtr)     - On every node of the insertion or removal path, from the bottom up.
+//                               Returns the (possibly rotated) subtree root. subTreePtr may be null.
+//   afterInsert(root, node)   - Once the new node is linked. Returns the (possibly rebuilt) root.
+//   afterRemove(root)         - Once a node has been removed. Returns the (possibly rebuilt) root.
+//   afterBuild(root)          - Once BinarySearchTree::assign() has linked a perfectly balanced tree, whose
+//                               right subtrees are never smaller than their left siblings. Its nodes skip
+//                               initNode, so this gives every node its balance data. Returns the root.
+//   reset()                   - When the tree is cleared.
+
+//------------------------------------------------------------
+// BalancePolicyBase : rotations, rebuilds and their counters.
+//------------------------------------------------------------
+class BalancePolicyBase
+{
+protected:
+	long long rotationCount;
+	long long rebuildCount;
+
+	// Rotates the subtree to the left and returns its new root (the former right child).
+	template<class ItemType>
+	NodeUnit rotateLeft(NodeUnit nodePtr)
+	{
+		NodeUnit rightPtr = nodePtr->getRightChildPtr();
+		nodePtr->setRightChildPtr(rightPtr->getLeftChildPtr());
+		rightPtr->setLeftChildPtr(nodePtr);
+
+		rotationCount++;
+		return rightPtr;
+	}
+
+	// Rotates the subtree to the right and returns its new root (the former left child).
+	template<class ItemType>
+	NodeUnit rotateRight(NodeUnit nodePtr)
+	{
+		NodeUnit leftPtr = nodePtr->getLeftChildPtr();
+		nodePtr->setLeftChildPtr(leftPtr->getRightChildPtr());
+		leftPtr->setRightChildPtr(nodePtr);
+
+		rotationCount++;
+		return leftPtr;
+	}
+
+	// Collects the nodes of a subtree in inorder.
+	template<class ItemType>
+	static void collectInorder(NodeUnit subTreePtr, vector<NodeUnit>& nodes)
+	{
+		if (subTreePtr.get() == nullptr) return;
+
+		collectInorder(subTreePtr->getLeftChildPtr(), nodes);
+		nodes.push_back(subTreePtr);
+		collectInorder(subTreePtr->getRightChildPtr(), nodes);
+	}
+
+	// Relinks nodes[first, last) into a perfectly balanced subtree and returns its root.
+	template<class ItemType>
+	static NodeUnit linkBalanced(vector<NodeUnit>& nodes, int first, int last)
+	{
+		if (first >= last) return nullptr;
+
+		int middle = first + (last - first) / 2;
+		NodeUnit middlePtr = nodes[middle];
+
+		middlePtr->setLeftChildPtr(linkBalanced(nodes, first, middle));
+		middlePtr->setRightChildPtr(linkBalanced(nodes, middle + 1, last));
+
+		return middlePtr;
+	}
+
+	// Rebuilds a subtree into a perfectly balanced one, reusing its nodes.
+	template<class ItemType>
+	NodeUnit rebuildSubtree(NodeUnit subTreePtr)
+	{
+		vector<NodeUnit> nodes;
+		collectInorder(subTreePtr, nodes);
+
+		rebuildCount++;
+		return linkBalanced(nodes, 0, (int)nodes.size());
+	}
+
+public:
+	BalancePolicyBase() : rotationCount(0), rebuildCount(0) {}
+
+	long long getRotationCount() const { return rotationCount; }
+	long long getRebuildCount() const { return rebuildCount; }
+
+	template<class ItemType>
+	void initNode(BinaryUnit& /* node */) {}
+
+	template<class ItemType>
+	NodeUnit rebalance(NodeUnit subTreePtr) { return subTreePtr; }
+
+	template<class ItemType>
+	NodeUnit afterInsert(NodeUnit rootPtr, const NodeUnit& /* newNodePtr */) { return rootPtr; }
+
+	template<class ItemType>
+	NodeUnit afterRemove(NodeUnit rootPtr) { return rootPtr; }
+
+	template<class ItemType>
+	NodeUnit afterBuild(NodeUnit rootPtr) { return rootPtr; }
+
+	void reset() {}
+}; // end BalancePolicyBase
+
+//------------------------------------------------------------
+// UnbalancedPolicy : a plain binary search tree. Sorted input links a chain, which costs O(n) per operation but
+// no stack depth : the insertion and removal paths are loops. Pick a balanced policy for such input.
+//------------------------------------------------------------
+class UnbalancedPolicy : public BalancePolicyBase
+{
+}; // end UnbalancedPolicy
+
+//------------------------------------------------------------
+// AvlPolicy : the heights of the two subtrees of any node differ by at most one.
+// Uses the subtree height cached in every node.
+//------------------------------------------------------------
+class AvlPolicy : public BalancePolicyBase
+{
+private:
+	template<class ItemType>
+	static int heightOf(const NodeUnit& nodePtr)
+	{
+		return (nodePtr.get() == nullptr) ? 0 : nodePtr->getHeight();
+	}
+
+public:
+	template<class ItemType>
+	NodeUnit rebalance(NodeUnit subTreePtr)
+	{
+		if (subTreePtr.get() == nullptr) return subTreePtr;
+
+		NodeUnit leftPtr = subTreePtr->getLeftChildPtr();
+		NodeUnit rightPtr = subTreePtr->getRightChildPtr();
+		int balance = heightOf(leftPtr) - heightOf(rightPtr);
+
+		if (balance > 1)
+		{
+			if (heightOf(leftPtr->getLeftChildPtr()) < heightOf(leftPtr->getRightChildPtr()))
+				subTreePtr->setLeftChildPtr(rotateLeft(leftPtr));
+
+			subTreePtr = rotateRight(subTreePtr);
+		}
+		else if (balance < -1)
+		{
+			if (heightOf(rightPtr->getRightChildPtr()) < heightOf(rightPtr->getLeftChildPtr()))
+				subTreePtr->setRightChildPtr(rotateRight(rightPtr));
+
+			subTreePtr = rotateLeft(subTreePtr);
+		}
+
+		return subTreePtr;
+	}
+}; // end AvlPolicy
+
+//------------------------------------------------------------
+// RedBlackPolicy : red-black balancing in Andersson's level form (AA tree).
+// The node's balance data is its level, i.e. its black height. A red node is a right child
+// on the same level as its parent, and two red nodes are never adjacent.
+// Both insertion and removal are repaired with skew and split on the way up.
+//------------------------------------------------------------
+class RedBlackPolicy : public BalancePolicyBase
+{
+private:
+	template<class ItemType>
+	static int levelOf(const NodeUnit& nodePtr)
+	{
+		return (nodePtr.get() == nullptr) ? 0 : nodePtr->getBalanceData();
+	}
+
+	// Removes a red left child by rotating right.
+	template<class ItemType>
+	NodeUnit skew(NodeUnit nodePtr)
+	{
+		if (nodePtr.get() == nullptr) return nodePtr;
+
+		NodeUnit leftPtr = nodePtr->getLeftChildPtr();
+		if (leftPtr.get() != nullptr && leftPtr->getBalanceData() == nodePtr->getBalanceData())
+			return rotateRight(nodePtr);
+
+		return nodePtr;
+	}
+
+	// Removes two consecutive red right children by rotating left and promoting the middle node.
+	template<class ItemType>
+	NodeUnit split(NodeUnit nodePtr)
+	{
+		if (nodePtr.get() == nullptr) return nodePtr;
+
+		NodeUnit rightPtr = nodePtr->getRightChildPtr();
+		if (rightPtr.get() != nullptr && levelOf(rightPtr->getRightChildPtr()) == nodePtr->getBalanceData())
+		{
+			NodeUnit newRootPtr = rotateLeft(nodePtr);
+			newRootPtr->setBalanceData(newRootPtr->getBalanceData() + 1);
+			return newRootPtr;
+		}
+
+		return nodePtr;
+	}
+
+	// Gives every node of a balanced tree its level : the length of its shortest path down to an empty link.
+	// As right subtrees are never smaller than their siblings, a left child is always one level down
+	// and no two right children in a row stay on the same level.
+	template<class ItemType>
+	static int assignLevels(const NodeUnit& nodePtr)
+	{
+		if (nodePtr.get() == nullptr) return 0;
+
+		int leftLevel = assignLevels(nodePtr->getLeftChildPtr());
+		int rightLevel = assignLevels(nodePtr->getRightChildPtr());
+
+		nodePtr->setBalanceData(1 + min(leftLevel, rightLevel));
+		return nodePtr->getBalanceData();
+	}
+
+public:
+	template<class ItemType>
+	void initNode(BinaryUnit& node) { node.setBalanceData(1); }
+
+	template<class ItemType>
+	NodeUnit afterBuild(NodeUnit rootPtr)
+	{
+		assignLevels(rootPtr);
+		return rootPtr;
+	}
+
+	template<class ItemType>
+	NodeUnit rebalance(NodeUnit subTreePtr)
+	{
+		if (subTreePtr.get() == nullptr) return subTreePtr;
+
+		// A removal below may have lowered a child's level
+		int expectedLevel = min(levelOf(subTreePtr->getLeftChildPtr()), levelOf(subTreePtr->getRightChildPtr())) + 1;
+		if (expectedLevel < subTreePtr->getBalanceData())
+		{
+			subTreePtr->setBalanceData(expectedLevel);
+
+			NodeUnit rightPtr = subTreePtr->getRightChildPtr();
+			if (levelOf(rightPtr) > expectedLevel) rightPtr->setBalanceData(expectedLevel);
+		}
+
+		subTreePtr = skew(subTreePtr);
+
+		NodeUnit rightPtr = subTreePtr->getRightChildPtr();
+		if (rightPtr.get() != nullptr)
+		{
+			rightPtr = skew(rightPtr);
+			rightPtr->setRightChildPtr(skew(rightPtr->getRightChildPtr()));
+			subTreePtr->setRightChildPtr(rightPtr);
+		}
+
+		subTreePtr = split(subTreePtr);
+		subTreePtr->setRightChildPtr(split(subTreePtr->getRightChildPtr()));
+
+		return subTreePtr;
+	}
+}; // end RedBlackPolicy
+
+//------------------------------------------------------------
+// TreapPolicy : every node gets a random priority and the tree is kept heap-ordered on it,
+// which gives an expected height of O(log n) whatever the insertion order.
+// The node's balance data is its priority.
+//------------------------------------------------------------
+class TreapPolicy : public BalancePolicyBase
+{
+private:
+	std::mt19937 generator;
+
+	template<class ItemType>
+	static bool outranks(const NodeUnit& childPtr, const NodeUnit& nodePtr)
+	{
+		return (childPtr.get() != nullptr && childPtr->getBalanceData() > nodePtr->getBalanceData());
+	}
+
+	// Draws each priority at random within a band that drops with the depth, so every node outranks its children.
+	template<class ItemType>
+	void assignPriorities(const NodeUnit& nodePtr, int bandsBelow, int bandSize)
+	{
+		if (nodePtr.get() == nullptr) return;
+
+		nodePtr->setBalanceData(bandsBelow * bandSize + (int)(generator() % (unsigned int)bandSize));
+
+		assignPriorities(nodePtr->getLeftChildPtr(), bandsBelow - 1, bandSize);
+		assignPriorities(nodePtr->getRightChildPtr(), bandsBelow - 1, bandSize);
+	}
+
+public:
+	TreapPolicy() : generator(std::random_device()()) {}
+
+	template<class ItemType>
+	void initNode(BinaryUnit& node) { node.setBalanceData((int)(generator() >> 1)); }
+
+	template<class ItemType>
+	NodeUnit afterBuild(NodeUnit rootPtr)
+	{
+		if (rootPtr.get() == nullptr) return rootPtr;
+
+		int height = rootPtr->getHeight();
+		assignPriorities(rootPtr, height - 1, INT_MAX / height);
+		return rootPtr;
+	}
+
+	template<class ItemType>
+	NodeUnit rebalance(NodeUnit subTreePtr)
+	{
+		if (subTreePtr.get() == nullptr) return subTreePtr;
+
+		if (outranks(subTreePtr->getLeftChildPtr(), subTreePtr))
+			subTreePtr = rotateRight(subTreePtr);
+		else if (outranks(subTreePtr->getRightChildPtr(), subTreePtr))
+			subTreePtr = rotateLeft(subTreePtr);
+
+		return subTreePtr;
+	}
+}; // end TreapPolicy
+
+//------------------------------------------------------------
+// ScapegoatPolicy : uses the subtree node counts cached in every node. When an insertion lands deeper than log(3/2) of the node count,
+// the lowest unbalanced ancestor (the scapegoat) is rebuilt into a perfectly balanced subtree.
+// The whole tree is rebuilt once removals shrink it below 2/3 of its peak size.
+//------------------------------------------------------------
+class ScapegoatPolicy : public BalancePolicyBase
+{
+private:
+	int maxNodeCount;
+
+	static int depthLimit(int count)
+	{
+		return (int)floor(log((double)count) / log(1.5));
+	}
+
+public:
+	ScapegoatPolicy() : maxNodeCount(0) {}
+
+	template<class ItemType>
+	NodeUnit afterInsert(NodeUnit rootPtr, const NodeUnit& newNodePtr)
+	{
+		int nodeCount = rootPtr->getNodeCount();
+		maxNodeCount = max(maxNodeCount, nodeCount);
+
+		// Record the path down to the new node (equal entries were placed to the right)
+		vector<NodeUnit> path;
+		NodeUnit currentPtr = rootPtr;
+		while (currentPtr != newNodePtr)
+		{
+			path.push_back(currentPtr);
+			if (newNodePtr->getItem() < currentPtr->getItem())
+				currentPtr = currentPtr->getLeftChildPtr();
+			else
+				currentPtr = currentPtr->getRightChildPtr();
+		}
+
+		if ((int)path.size() <= depthLimit(nodeCount)) return rootPtr;
+
+		// Walk back up until an ancestor is out of weight balance
+		NodeUnit childPtr = newNodePtr;
+		for (int i = (int)path.size() - 1; i >= 0; i--)
+		{
+			NodeUnit nodePtr = path[i];
+
+			if (3 * childPtr->getNodeCount() > 2 * nodePtr->getNodeCount())
+			{
+				NodeUnit rebuiltPtr = rebuildSubtree(nodePtr);
+
+				if (i == 0) return rebuiltPtr;
+
+				if (path[i - 1]->getLeftChildPtr() == nodePtr)
+					path[i - 1]->setLeftChildPtr(rebuiltPtr);
+				else
+					path[i - 1]->setRightChildPtr(rebuiltPtr);
+
+				// The rebuilt subtree may be shorter, so the remaining ancestors refresh their heights
+				for (int j = i - 2; j >= 0; j--)
+					path[j]->updateSubtreeInfo();
+
+				return rootPtr;
+			}
+
+			childPtr = nodePtr;
+		}
+
+		return rootPtr;
+	}
+
+	template<class ItemType>
+	NodeUnit afterRemove(NodeUnit rootPtr)
+	{
+		int nodeCount = (rootPtr.get() == nullptr) ? 0 : rootPtr->getNodeCount();
+
+		if (3 * nodeCount < 2 * maxNodeCount)
+		{
+			maxNodeCount = nodeCount;
+			return rebuildSubtree(rootPtr);
+		}
+
+		return rootPtr;
+	}
+
+	template<class ItemType>
+	NodeUnit afterBuild(NodeUnit rootPtr)
+	{
+		maxNodeCount = (rootPtr.get() == nullptr) ? 0 : rootPtr->getNodeCount();
+		return rootPtr;
+	}
+
+	void reset()
+	{
+		maxNodeCount = 0;
+	}
+}; // end ScapegoatPolicy
+
+#endif
@@ -0,0 +1,850 @@
+#include "General.h"
+#include "Soundtrack.h"
+#include "BinarySearchTree.h"
+#include "ConcurrentSearchTree.h"
+#include "LockFreeSkipList.h"
+#include "BTree.h"
+#include <set>
+#include <map>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <cstring>
+
+// Stress checks and timings for the concurrent and bulk operations, kept apart from TopicD.cpp, which shows the
+// tree shapes. This file has its own main(), so the project excludes it from the build : to run it, exclude
+// TopicD.cpp instead, or build it on its own with PrecondViolatedExcept.cpp, Soundtrack.cpp and SoundtrackCatalog.cpp
+// (with optimizations on, e.g. cl /O2 /EHsc or g++ -O2 -pthread).
+//
+// "Benchmark" runs every section, "Benchmark name..." only the named ones. Each section prints one table.
+// Thread counts above the number of hardware threads still run : they then measure oversubscription, not scaling.
+// A failed check is printed, and makes the program return 1.
+
+typedef std::chrono::steady_clock Clock;
+
+struct BenchmarkSection
+{
+	const char* name;
+	void(*run)();
+};
+
+static const int writerCounts[] = { 1, 2, 4, 8, 16, 32 };
+static const int readerCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+static std::atomic<int> failureCount(0);
+
+// Records a failed check.
+void check(bool condition, const char* what);
+
+// Returns the seconds elapsed since start.
+double secondsSince(Clock::time_point start);
+
+// Runs work(threadIndex) on threadCount threads and returns the seconds until all of them have finished.
+template<class Work>
+double timeThreads(int threadCount, Work work);
+
+// Returns a soundtrack whose fields all derive from number, so that different numbers give different records.
+soundtrack makeSoundtrack(int number);
+
+// Sections
+void completeTreeInsert();
+void soundtrackLookup();
+void soundtrackScan();
+void readerTraversal();
+void traversalModes();
+void bTreeVersusBinary();
+void concurrentReaders();
+void parallelReduceScaling();
+void skipListChurn();
+void skipListClear();
+void skipListWriters();
+
+static const BenchmarkSection sections[] =
+{
+	{ "complete-insert", &completeTreeInsert },
+	{ "soundtrack-lookup", &soundtrackLookup },
+	{ "soundtrack-scan", &soundtrackScan },
+	{ "reader-traversal", &readerTraversal },
+	{ "traversal-modes", &traversalModes },
+	{ "btree", &bTreeVersusBinary },
+	{ "concurrent-readers", &concurrentReaders },
+	{ "parallel-reduce", &parallelReduceScaling },
+	{ "skiplist-churn", &skipListChurn },
+	{ "skiplist-clear", &skipListClear },
+	{ "skiplist-writers", &skipListWriters },
+};
+
+int main(int argc, char* argv[])
+{
+	cout << "Hardware threads : " << std::thread::hardware_concurrency() << endl << endl;
+
+	for (const BenchmarkSection& section : sections)
+	{
+		bool isSelected = (argc < 2);
+		for (int i = 1; i < argc; i++)
+		{
+			if (strcmp(argv[i], section.name) == 0) isSelected = true;
+		}
+
+		if (!isSelected) continue;
+
+		cout << "[" << section.name << "]" << endl;
+		section.run();
+		cout << endl;
+	}
+
+	cout << ((failureCount.load() == 0) ? "All checks passed" : "Some checks FAILED") << endl;
+	return (failureCount.load() == 0) ? 0 : 1;
+}
+
+void check(bool condition, const char* what)
+{
+	if (!condition && failureCount.fetch_add(1) < 20)
+		cout << "FAILED : " << what << endl;
+}
+
+double secondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template<class Work>
+double timeThreads(int threadCount, Work work)
+{
+	vector<std::thread> threads;
+	Clock::time_point start = Clock::now();
+
+	for (int i = 0; i < threadCount; i++)
+		threads.push_back(std::thread(work, i));
+
+	for (size_t i = 0; i < threads.size(); i++)
+		threads[i].join();
+
+	return secondsSince(start);
+}
+
+soundtrack makeSoundtrack(int number)
+{
+	soundtrack record;
+	record.setComposer("Composer " + std::to_string(number % 997));
+	record.setTitle("Title " + std::to_string(number));
+	record.setLabel("Label " + std::to_string(number % 31));
+	record.setCatalogNumber("CAT-" + std::to_string(number));
+	record.setYearRecorded(std::to_string(1950 + number % 70));
+	record.setYearReleased(1951 + number % 70);
+	return record;
+}
+
+// Collects the entries of a traversal, which takes a plain function.
+static vector<int> visitedInts;
+
+static void collectInt(int& item)
+{
+	visitedInts.push_back(item);
+}
+
+// Adds up the title lengths of the soundtracks visited, for a traversal taking a plain function.
+static size_t titleCharacters = 0;
+
+static void addTitleCharacters(soundtrack& item)
+{
+	titleCharacters += item.getTitle().size();
+}
+
+// A BinarySearchTree<int> that can be filled with a right chain (every node the right child of the one before)
+// in O(n) : add() would walk the whole chain for each entry, in O(n^2).
+class RightChainTree : public BinarySearchTree<int>
+{
+public:
+	// Replaces the entries with 0 to count - 1, linked from the bottom up so each node's cached info is right.
+	void assignRightChain(int count)
+	{
+		shared_ptr<BinaryNode<int> > chainPtr;
+
+		for (int i = count - 1; i >= 0; i--)
+		{
+			shared_ptr<BinaryNode<int> > nodePtr = this->createNode(i);
+			nodePtr->setRightChildPtr(std::move(chainPtr));
+			chainPtr = std::move(nodePtr);
+		}
+
+		this->clear();
+		this->getRootReference() = std::move(chainPtr);
+	}
+};
+
+// Sums the entries a thread visits, for a traversal taking a plain function.
+static thread_local long long readerSum = 0;
+
+static void addToReaderSum(int& item)
+{
+	readerSum += item;
+}
+
+// Writers add and remove keys of their own (key % writers == writer) and of a few keys they all share, each thread
+// keeping a std::multiset of what it added and removed. Afterwards the list must hold exactly the union of the models.
+void skipListChurn()
+{
+	const int operationsPerWriter = 100000;
+	const int keysPerWriter = 2000;
+
+	cout << setw(8) << "writers" << setw(12) << "entries" << setw(12) << "seconds" << endl;
+
+	for (int writers : writerCounts)
+	{
+		LockFreeSkipList<int> list;
+		vector<std::multiset<int> > models(writers);
+
+		double seconds = timeThreads(writers, [&](int writer)
+		{
+			std::mt19937 generator(writer + 1);
+			std::multiset<int>& model = models[writer];
+
+			for (int i = 0; i < operationsPerWriter; i++)
+			{
+				int key = (int)(generator() % keysPerWriter) * writers + writer;
+
+				if (generator() % 2 == 0)
+				{
+					list.add(key);
+					model.insert(key);
+				}
+				else
+				{
+					std::multiset<int>::iterator modelIter = model.find(key);
+					bool isInModel = (modelIter != model.end());
+					if (isInModel) model.erase(modelIter);
+
+					check(list.remove(key) == isInModel, "skiplist-churn : remove() disagrees with the model");
+				}
+
+				// Shared keys are negative, so they never meet the writers' own keys
+				int sharedKey = -1 - (int)(generator() % 8);
+				list.add(sharedKey);
+				check(list.contains(sharedKey), "skiplist-churn : a shared key just added is missing");
+				check(list.remove(sharedKey), "skiplist-churn : a shared key just added cannot be removed");
+			}
+		});
+
+		std::multiset<int> expected;
+		for (int writer = 0; writer < writers; writer++)
+			expected.insert(models[writer].begin(), models[writer].end());
+
+		visitedInts.clear();
+		list.inorderTraverse(&collectInt);
+
+		check(visitedInts == vector<int>(expected.begin(), expected.end()), "skiplist-churn : entries differ from the model");
+		check(list.getNumberOfNodes() == (int)expected.size(), "skiplist-churn : getNumberOfNodes() differs from the model");
+
+		cout << setw(8) << writers << setw(12) << expected.size() << setw(12) << fixed << setprecision(3) << seconds << endl;
+	}
+} // End skipListChurn()
+
+// Writers add and remove their own keys, as above, while one more thread keeps calling clear().
+// clear() only removes entries, so afterwards the list must hold a part of each writer's model : never a key the
+// writer did not add, nor more copies than the model has. A last clear() must leave the list empty.
+void skipListClear()
+{
+	const int operationsPerWriter = 50000;
+	const int keysPerWriter = 500;
+
+	cout << setw(8) << "writers" << setw(10) << "clears" << setw(12) << "entries" << setw(12) << "seconds" << endl;
+
+	for (int writers : writerCounts)
+	{
+		LockFreeSkipList<int> list;
+		vector<std::multiset<int> > models(writers);
+		std::atomic<int> runningWriters(writers);
+		int clearCount = 0;
+
+		// The last thread clears
+		double seconds = timeThreads(writers + 1, [&](int thread)
+		{
+			if (thread == writers)
+			{
+				while (runningWriters.load() > 0)
+				{
+					list.clear();
+					clearCount++;
+					std::this_thread::yield();
+				}
+				return;
+			}
+
+			std::mt19937 generator(thread + 1);
+			std::multiset<int>& model = models[thread];
+
+			for (int i = 0; i < operationsPerWriter; i++)
+			{
+				int key = (int)(generator() % keysPerWriter) * writers + thread;
+
+				if (generator() % 2 == 0)
+				{
+					list.add(key);
+					model.insert(key);
+				}
+				else if (list.remove(key))
+				{
+					std::multiset<int>::iterator modelIter = model.find(key);
+					check(modelIter != model.end(), "skiplist-clear : removed a key the writer did not add");
+					if (modelIter != model.end()) model.erase(modelIter);
+				}
+			}
+
+			runningWriters.fetch_sub(1);
+		});
+
+		visitedInts.clear();
+		list.inorderTraverse(&collectInt);
+
+		check(std::is_sorted(visitedInts.begin(), visitedInts.end()), "skiplist-clear : entries out of order");
+		check(list.getNumberOfNodes() == (int)visitedInts.size(), "skiplist-clear : getNumberOfNodes() differs from the entries");
+
+		std::map<int, int> counts;
+		for (size_t i = 0; i < visitedInts.size(); i++)
+			counts[visitedInts[i]]++;
+
+		for (std::map<int, int>::const_iterator countIter = counts.begin(); countIter != counts.end(); ++countIter)
+		{
+			int writer = countIter->first % writers;
+			check((int)models[writer].count(countIter->first) >= countIter->second, "skiplist-clear : an entry is not in its writer's model");
+		}
+
+		int entries = (int)visitedInts.size();
+		list.clear();
+		check(list.isEmpty() && list.getNumberOfNodes() == 0, "skiplist-clear : clear() left entries");
+
+		cout << setw(8) << writers << setw(10) << clearCount << setw(12) << entries << setw(12) << fixed << setprecision(3) << seconds << endl;
+	}
+} // End skipListClear()
+
+// Throughput of a 50/50 add and remove mix over 100000 keys, split among 1 to 32 writers, against the same mix on a
+// BinarySearchTree<int, AvlPolicy> behind one mutex.
+void skipListWriters()
+{
+	const int totalOperations = 400000;
+	const int keyRange = 100000;
+
+	cout << "Million operations per second, " << totalOperations << " operations over " << keyRange << " keys" << endl;
+	cout << setw(8) << "writers" << setw(18) << "LockFreeSkipList" << setw(18) << "mutex + AVL BST" << endl;
+
+	for (int writers : writerCounts)
+	{
+		LockFreeSkipList<int> list;
+		BinarySearchTree<int, AvlPolicy> tree;
+		std::mutex treeMutex;
+
+		// Both start half full, so removals find something
+		std::mt19937 generator(0);
+		for (int i = 0; i < keyRange / 2; i++)
+		{
+			int key = (int)(generator() % keyRange);
+			list.add(key);
+			tree.add(key);
+		}
+
+		double listSeconds = timeThreads(writers, [&](int writer)
+		{
+			std::mt19937 writerGenerator(writer + 1);
+			for (int i = 0; i < totalOperations / writers; i++)
+			{
+				int key = (int)(writerGenerator() % keyRange);
+				if (i % 2 == 0) list.add(key);
+				else list.remove(key);
+			}
+		});
+
+		double treeSeconds = timeThreads(writers, [&](int writer)
+		{
+			std::mt19937 writerGenerator(writer + 1);
+			for (int i = 0; i < totalOperations / writers; i++)
+			{
+				int key = (int)(writerGenerator() % keyRange);
+				std::lock_guard<std::mutex> lock(treeMutex);
+				if (i % 2 == 0) tree.add(key);
+				else tree.remove(key);
+			}
+		});
+
+		cout << setw(8) << writers << fixed << setprecision(2)
+			<< setw(18) << totalOperations / listSeconds / 1e6
+			<< setw(18) << totalOperations / treeSeconds / 1e6 << endl;
+	}
+} // End skipListWriters()
+
+// Looking up a whole soundtrack in a BinarySearchTree<soundtrack> : contains() walks one path ordered by operator<,
+// while forEachMatching() compares every entry with the wildcard operator==, which is what every lookup cost
+// before the tree was ordered.
+void soundtrackLookup()
+{
+	const int treeSizes[] = { 1000, 10000, 100000, 1000000 };
+
+	cout << "Microseconds per lookup of a stored soundtrack" << endl;
+	cout << setw(10) << "entries" << setw(14) << "contains()" << setw(20) << "forEachMatching()" << setw(10) << "ratio" << endl;
+
+	for (int entries : treeSizes)
+	{
+		vector<soundtrack> records;
+		for (int i = 0; i < entries; i++)
+			records.push_back(makeSoundtrack(i));
+
+		BinarySearchTree<soundtrack> tree;
+		tree.assign(records.begin(), records.end());
+
+		// The scans run about 10^7 comparisons in all
+		const int scanLookups = max(10, 10000000 / entries);
+		const int orderedLookups = 200000;
+		std::mt19937 generator(1);
+
+		Clock::time_point start = Clock::now();
+		int found = 0;
+		for (int i = 0; i < orderedLookups; i++)
+			found += tree.contains(records[generator() % entries]) ? 1 : 0;
+		double orderedSeconds = secondsSince(start);
+		check(found == orderedLookups, "soundtrack-lookup : contains() missed a stored soundtrack");
+
+		start = Clock::now();
+		found = 0;
+		for (int i = 0; i < scanLookups; i++)
+			tree.forEachMatching(records[generator() % entries], [&found](const soundtrack&) { found++; return false; });
+		double scanSeconds = secondsSince(start);
+		check(found == scanLookups, "soundtrack-lookup : forEachMatching() missed a stored soundtrack");
+
+		// A pattern with only the composer set matches every record of that composer
+		soundtrack composerPattern;
+		composerPattern.setComposer("Composer 5");
+		int composerMatches = 0;
+		tree.forEachMatching(composerPattern, [&composerMatches](const soundtrack&) { composerMatches++; });
+		check(composerMatches == (entries - 5 + 996) / 997, "soundtrack-lookup : forEachMatching() missed a wildcard match");
+
+		double orderedMicroseconds = orderedSeconds / orderedLookups * 1e6;
+		double scanMicroseconds = scanSeconds / scanLookups * 1e6;
+
+		cout << setw(10) << entries << fixed << setprecision(2) << setw(14) << orderedMicroseconds
+			<< setw(20) << scanMicroseconds << setw(9) << setprecision(0) << scanMicroseconds / orderedMicroseconds << "x" << endl;
+	}
+} // End soundtrackLookup()
+
+// Cost of BinaryNodeTree::add(), which keeps the tree complete and level-filled, as the tree grows. The next slot
+// comes from the node count, so the cost per add() should grow with the height only.
+// The general order must still give the entries in the order they were added.
+void completeTreeInsert()
+{
+	BinaryNodeTree<int> tree;
+	int count = 0;
+
+	cout << setw(10) << "nodes" << setw(16) << "ns per add()" << endl;
+
+	for (int nodes = 1 << 10; nodes <= 1 << 22; nodes <<= 2)
+	{
+		int added = nodes - count;
+		Clock::time_point start = Clock::now();
+
+		for (; count < nodes; count++)
+			tree.add(count);
+
+		double seconds = secondsSince(start);
+		cout << setw(10) << nodes << setw(16) << fixed << setprecision(1) << seconds / added * 1e9 << endl;
+	}
+
+	check(tree.getNumberOfNodes() == count, "complete-insert : getNumberOfNodes() differs from the adds");
+
+	visitedInts.clear();
+	tree.generalOrderTraverse(&collectInt);
+
+	bool isInOrder = ((int)visitedInts.size() == count);
+	for (int i = 0; isInOrder && i < count; i++)
+		isInOrder = (visitedInts[i] == i);
+
+	check(isInOrder, "complete-insert : the general order is not the order of the adds");
+} // End completeTreeInsert()
+
+// Readers sharing one BinarySearchTree<int> : full inorder traversals, then contains() lookups, split among 1 to 32
+// threads. Each step borrows the child links instead of copying a shared_ptr, so the readers write nothing shared.
+void readerTraversal()
+{
+	const int treeSizes[] = { 1 << 15, 1 << 20 };
+	const long long totalVisits = 1LL << 25;
+	const int totalLookups = 1 << 21;
+
+	cout << "Million entries visited or looked up per second, all readers together" << endl;
+	cout << setw(10) << "entries" << setw(8) << "readers" << setw(18) << "inorderTraverse" << setw(14) << "contains()" << endl;
+
+	for (int entries : treeSizes)
+	{
+		vector<int> items(entries);
+		for (int i = 0; i < entries; i++)
+			items[i] = i;
+
+		BinarySearchTree<int> tree;
+		tree.assign(items.begin(), items.end());
+		const long long expectedSum = (long long)entries * (entries - 1) / 2;
+
+		for (int readers : writerCounts)
+		{
+			const int passes = (int)max(1LL, totalVisits / entries / readers);
+
+			double traverseSeconds = timeThreads(readers, [&](int)
+			{
+				readerSum = 0;
+				for (int pass = 0; pass < passes; pass++)
+					tree.inorderTraverse(&addToReaderSum);
+
+				check(readerSum == passes * expectedSum, "reader-traversal : a traversal missed entries");
+			});
+
+			double lookupSeconds = timeThreads(readers, [&](int reader)
+			{
+				std::mt19937 generator(reader + 1);
+				int found = 0;
+				for (int i = 0; i < totalLookups / readers; i++)
+					found += tree.contains((int)(generator() % entries)) ? 1 : 0;
+
+				check(found == totalLookups / readers, "reader-traversal : contains() missed a stored entry");
+			});
+
+			cout << setw(10) << entries << setw(8) << readers << fixed << setprecision(1)
+				<< setw(18) << (double)passes * readers * entries / traverseSeconds / 1e6
+				<< setw(14) << (double)(totalLookups / readers) * readers / lookupSeconds / 1e6 << endl;
+		}
+	}
+} // End readerTraversal()
+
+// BTree<int> against BinarySearchTree<int, AvlPolicy> : adding random keys, looking up random keys (about half of
+// them stored at the larger sizes) and one inorder scan. Both must find the same keys and visit the same entries.
+void bTreeVersusBinary()
+{
+	const int keyCounts[] = { 10000, 100000, 1000000, 10000000 };
+	const int lookups = 1000000;
+
+	cout << "Nanoseconds per operation (scan : per entry)" << endl;
+	cout << setw(10) << "keys" << setw(12) << "add BTree" << setw(10) << "add AVL" << setw(12) << "find BTree"
+		<< setw(10) << "find AVL" << setw(12) << "scan BTree" << setw(10) << "scan AVL" << endl;
+
+	for (int keyCount : keyCounts)
+	{
+		// Keys spread over twice their count, so that lookups miss about as often as they hit
+		std::mt19937 generator(keyCount);
+		vector<int> keys(keyCount);
+		for (int i = 0; i < keyCount; i++)
+			keys[i] = (int)(generator() % (2u * keyCount));
+
+		vector<int> targets(lookups);
+		for (int i = 0; i < lookups; i++)
+			targets[i] = (int)(generator() % (2u * keyCount));
+
+		double seconds[6];
+		int found[2] = { 0, 0 };
+		long long sums[2];
+
+		{
+			BTree<int> bTree;
+			Clock::time_point start = Clock::now();
+			for (int i = 0; i < keyCount; i++)
+				bTree.add(keys[i]);
+			seconds[0] = secondsSince(start);
+
+			start = Clock::now();
+			for (int i = 0; i < lookups; i++)
+				found[0] += bTree.contains(targets[i]) ? 1 : 0;
+			seconds[2] = secondsSince(start);
+
+			readerSum = 0;
+			start = Clock::now();
+			bTree.inorderTraverse(&addToReaderSum);
+			seconds[4] = secondsSince(start);
+			sums[0] = readerSum;
+		}
+
+		{
+			BinarySearchTree<int, AvlPolicy> avlTree;
+			Clock::time_point start = Clock::now();
+			for (int i = 0; i < keyCount; i++)
+				avlTree.add(keys[i]);
+			seconds[1] = secondsSince(start);
+
+			start = Clock::now();
+			for (int i = 0; i < lookups; i++)
+				found[1] += avlTree.contains(targets[i]) ? 1 : 0;
+			seconds[3] = secondsSince(start);
+
+			readerSum = 0;
+			start = Clock::now();
+			avlTree.inorderTraverse(&addToReaderSum);
+			seconds[5] = secondsSince(start);
+			sums[1] = readerSum;
+		}
+
+		check(found[0] == found[1], "btree : BTree and BinarySearchTree found different keys");
+		check(sums[0] == sums[1], "btree : BTree and BinarySearchTree scanned different entries");
+
+		cout << setw(10) << keyCount << fixed << setprecision(1)
+			<< setw(12) << seconds[0] / keyCount * 1e9 << setw(10) << seconds[1] / keyCount * 1e9
+			<< setw(12) << seconds[2] / lookups * 1e9 << setw(10) << seconds[3] / lookups * 1e9
+			<< setw(12) << seconds[4] / keyCount * 1e9 << setw(10) << seconds[5] / keyCount * 1e9 << endl;
+	}
+} // End bTreeVersusBinary()
+
+// One full scan of a BinarySearchTree<soundtrack> of 10^6 records, three ways : inorderTraverse() with a plain
+// function, which copies each record for the visitor as every traversal did before the iterators, then range-for
+// and std::count_if over the iterators, which hand out a reference to the stored record.
+void soundtrackScan()
+{
+	const int entries = 1000000;
+	const int scans = 3;
+
+	vector<soundtrack> records;
+	for (int i = 0; i < entries; i++)
+		records.push_back(makeSoundtrack(i));
+
+	BinarySearchTree<soundtrack> tree;
+	tree.assign(std::make_move_iterator(records.begin()), std::make_move_iterator(records.end()));
+	records.clear();
+
+	double bestSeconds[3] = { 1e9, 1e9, 1e9 };
+	size_t results[3];
+
+	for (int scan = 0; scan < scans; scan++)
+	{
+		titleCharacters = 0;
+		Clock::time_point start = Clock::now();
+		tree.inorderTraverse(&addTitleCharacters);
+		bestSeconds[0] = min(bestSeconds[0], secondsSince(start));
+		results[0] = titleCharacters;
+
+		size_t characters = 0;
+		start = Clock::now();
+		for (const soundtrack& record : tree)
+			characters += record.getTitle().size();
+		bestSeconds[1] = min(bestSeconds[1], secondsSince(start));
+		results[1] = characters;
+
+		start = Clock::now();
+		results[2] = (size_t)std::count_if(tree.begin(), tree.end(),
+			[](const soundtrack& record) { return record.getYearReleased() >= 2000; });
+		bestSeconds[2] = min(bestSeconds[2], secondsSince(start));
+	}
+
+	check(results[0] == results[1], "soundtrack-scan : the traversal and the iterators visited different records");
+	int releasedSince2000 = 0;
+	for (int i = 0; i < entries; i++)
+		releasedSince2000 += (makeSoundtrack(i).getYearReleased() >= 2000) ? 1 : 0;
+
+	check((int)results[2] == releasedSince2000, "soundtrack-scan : count_if() counted the wrong records");
+
+	cout << "Milliseconds per full scan of " << entries << " soundtracks, best of " << scans << endl;
+	cout << setw(34) << "inorderTraverse(plain function)" << setw(12) << fixed << setprecision(1) << bestSeconds[0] * 1e3 << endl;
+	cout << setw(34) << "range-for over iterators" << setw(12) << bestSeconds[1] * 1e3 << endl;
+	cout << setw(34) << "std::count_if over iterators" << setw(12) << bestSeconds[2] * 1e3 << endl;
+} // End soundtrackScan()
+
+// Lookups with 1% writes (adds and removes in turn) on 100000 keys, split among 1 to 64 threads : on a
+// ConcurrentSearchTree, whose readers never lock, and on a BinarySearchTree<int, AvlPolicy> behind one mutex.
+void concurrentReaders()
+{
+	const int totalOperations = 2000000;
+	const int keyRange = 100000;
+
+	cout << "Million operations per second, " << totalOperations << " operations, 1% writes" << endl;
+	cout << setw(8) << "threads" << setw(22) << "ConcurrentSearchTree" << setw(18) << "mutex + AVL BST" << endl;
+
+	for (int threads : readerCounts)
+	{
+		ConcurrentSearchTree<int> concurrentTree;
+		BinarySearchTree<int, AvlPolicy> tree;
+		std::mutex treeMutex;
+
+		// Both start with every even key
+		concurrentTree.update([&](PersistentSearchTree<int>& writerTree)
+		{
+			for (int key = 0; key < keyRange; key += 2)
+				writerTree.add(key);
+		});
+
+		for (int key = 0; key < keyRange; key += 2)
+			tree.add(key);
+
+		// Both trees must find about as many keys, which also keeps the compiler from dropping the lookups
+		std::atomic<int> foundCount(0);
+		std::atomic<int> treeFoundCount(0);
+
+		double concurrentSeconds = timeThreads(threads, [&](int thread)
+		{
+			ConcurrentSearchTree<int>::Reader reader(concurrentTree);
+			std::mt19937 generator(thread + 1);
+			int found = 0;
+
+			for (int i = 0; i < totalOperations / threads; i++)
+			{
+				int key = (int)(generator() % keyRange);
+
+				if (i % 100 != 99)
+					found += reader.contains(key) ? 1 : 0;
+				else if (i % 200 == 99)
+					concurrentTree.add(key | 1);
+				else
+					concurrentTree.remove(key | 1);
+			}
+
+			foundCount.fetch_add(found);
+		});
+
+		double treeSeconds = timeThreads(threads, [&](int thread)
+		{
+			std::mt19937 generator(thread + 1);
+			int found = 0;
+
+			for (int i = 0; i < totalOperations / threads; i++)
+			{
+				int key = (int)(generator() % keyRange);
+				std::lock_guard<std::mutex> lock(treeMutex);
+
+				if (i % 100 != 99)
+					found += tree.contains(key) ? 1 : 0;
+				else if (i % 200 == 99)
+					tree.add(key | 1);
+				else
+					tree.remove(key | 1);
+			}
+
+			treeFoundCount.fetch_add(found);
+		});
+
+		// Every even key stays, while odd keys are added and removed in turn, so the lookups of odd keys hit far less often
+		int lookups = totalOperations / threads * threads / 100 * 99;
+		check(foundCount.load() > lookups * 45 / 100 && foundCount.load() < lookups * 75 / 100, "concurrent-readers : ConcurrentSearchTree lookups hit too often or too rarely");
+		check(treeFoundCount.load() > lookups * 45 / 100 && treeFoundCount.load() < lookups * 75 / 100, "concurrent-readers : BinarySearchTree lookups hit too often or too rarely");
+
+		int operations = totalOperations / threads * threads;
+		cout << setw(8) << threads << fixed << setprecision(2)
+			<< setw(22) << operations / concurrentSeconds / 1e6
+			<< setw(18) << operations / treeSeconds / 1e6 << endl;
+	}
+} // End concurrentReaders()
+
+// Summing the entries of a BinarySearchTree<int> of 10^7 nodes with parallelReduce() on pools of 1 to 32 workers
+// (the calling thread works too), against one inorderTraverse() on the calling thread.
+void parallelReduceScaling()
+{
+	const int entries = 10000000;
+	const int runs = 3;
+
+	vector<int> items(entries);
+	for (int i = 0; i < entries; i++)
+		items[i] = i;
+
+	BinarySearchTree<int> tree;
+	tree.assign(items.begin(), items.end());
+	items = vector<int>();
+
+	const long long expectedSum = (long long)entries * (entries - 1) / 2;
+
+	double sequentialSeconds = 1e9;
+	for (int run = 0; run < runs; run++)
+	{
+		long long sum = 0;
+		Clock::time_point start = Clock::now();
+		tree.inorderTraverse([&sum](const int& item) { sum += item; });
+		sequentialSeconds = min(sequentialSeconds, secondsSince(start));
+
+		check(sum == expectedSum, "parallel-reduce : inorderTraverse() missed entries");
+	}
+
+	cout << "Milliseconds per sum of " << entries << " entries, best of " << runs << endl;
+	cout << setw(8) << "workers" << setw(14) << "milliseconds" << setw(10) << "speedup" << endl;
+	cout << setw(8) << "none" << fixed << setprecision(1) << setw(14) << sequentialSeconds * 1e3 << setw(10) << 1.0 << endl;
+
+	for (int workers : writerCounts)
+	{
+		WorkStealingPool pool(workers);
+		double bestSeconds = 1e9;
+
+		for (int run = 0; run < runs; run++)
+		{
+			Clock::time_point start = Clock::now();
+			long long sum = tree.parallelReduce(0LL,
+				[](long long& total, const int& item) { total += item; },
+				[](long long& left, const long long& right) { left += right; },
+				BinaryNodeTree<int>::defaultGrainSize, pool);
+			bestSeconds = min(bestSeconds, secondsSince(start));
+
+			check(sum == expectedSum, "parallel-reduce : parallelReduce() missed entries");
+		}
+
+		cout << setw(8) << workers << setw(14) << bestSeconds * 1e3 << setw(10) << sequentialSeconds / bestSeconds << endl;
+	}
+} // End parallelReduceScaling()
+
+// Preorder, inorder and postorder walks of 10^6 entries in each TraversalMode, on a balanced AVL tree and on a
+// right chain. Recursive is not run on the chain : it would need one call frame per node. Postorder has no
+// Morris walk and falls back to Iterative.
+void traversalModes()
+{
+	const int entries = 1000000;
+	const int runs = 3;
+	const long long expectedSum = (long long)entries * (entries - 1) / 2;
+
+	vector<int> items(entries);
+	for (int i = 0; i < entries; i++)
+		items[i] = i;
+
+	BinarySearchTree<int, AvlPolicy> avlTree;
+	avlTree.assign(items.begin(), items.end());
+	items = vector<int>();
+
+	RightChainTree chainTree;
+	chainTree.assignRightChain(entries);
+
+	check(chainTree.getHeight() == entries, "traversal-modes : the chain is not one node per level");
+
+	const TraversalMode modes[] = { TraversalMode::Recursive, TraversalMode::Iterative, TraversalMode::Morris };
+	const char* modeNames[] = { "Recursive", "Iterative", "Morris" };
+
+	cout << "Nanoseconds per entry, best of " << runs << ", AVL tree of height " << avlTree.getHeight()
+		<< " and right chain of height " << chainTree.getHeight() << endl;
+	cout << setw(10) << "mode" << setw(10) << "AVL pre" << setw(10) << "AVL in" << setw(10) << "AVL post"
+		<< setw(12) << "chain pre" << setw(11) << "chain in" << setw(12) << "chain post" << endl;
+
+	for (int m = 0; m < 3; m++)
+	{
+		cout << setw(10) << modeNames[m];
+
+		for (int t = 0; t < 2; t++)
+		{
+			const BinaryNodeTree<int>& tree = (t == 0) ? (const BinaryNodeTree<int>&)avlTree : (const BinaryNodeTree<int>&)chainTree;
+
+			for (int order = 0; order < 3; order++)
+			{
+				int width = (t == 0) ? 10 : ((order == 1) ? 11 : 12);
+
+				if (t == 1 && modes[m] == TraversalMode::Recursive)
+				{
+					cout << setw(width) << "-";
+					continue;
+				}
+
+				double bestSeconds = 1e9;
+				for (int run = 0; run < runs; run++)
+				{
+					long long sum = 0;
+					auto addToSum = [&sum](const int& item) { sum += item; };
+
+					Clock::time_point start = Clock::now();
+					if (order == 0) tree.preorderTraverse(addToSum, modes[m]);
+					else if (order == 1) tree.inorderTraverse(addToSum, modes[m]);
+					else tree.postorderTraverse(addToSum, modes[m]);
+					bestSeconds = min(bestSeconds, secondsSince(start));
+
+					check(sum == expectedSum, "traversal-modes : a traversal missed entries");
+				}
+
+				cout << setw(width) << fixed << setprecision(1) << bestSeconds / entries * 1e9;
+			}
+		}
+
+		cout << endl;
+	}
+} // End traversalModes()
@@ -13,39 +13,82 @@ private:
 	ItemType item;          // Data portion
 	NodeUnit leftChildPtr;  // Pointer to left child
 	NodeUnit rightChildPtr; // Pointer to right child
+	int balanceData;        // Balancing policy bookkeeping (red-black level or treap priority)
+	int height;             // Height of the subtree rooted at this node
+	int nodeCount;          // Number of nodes in the subtree rooted at this node
 
 public:
 	BinaryNode();
 	BinaryNode(const ItemType& anItem);
+	BinaryNode(ItemType&& anItem);
 	BinaryNode(const ItemType& anItem, NodeUnit leftPtr, NodeUnit rightPtr);
 
+	// Constructs the item in place from args, as in BinaryNode(std::piecewise_construct, args...).
+	template<class... Args>
+	BinaryNode(std::piecewise_construct_t, Args&&... args);
+
 	void setItem(const ItemType& anItem);
-	ItemType getItem() const;
+	void setItem(ItemType&& anItem);
+	const ItemType& getItem() const;
+
+	// The stored item, for moving it out of a node that is being unlinked.
+	ItemType& getItemReference();
 
 	bool isLeaf() const;
 
-	NodeUnit getLeftChildPtr() const;
-	NodeUnit getRightChildPtr() const;
+	// The links are owned by shared_ptr. These return the owning pointer by reference, so reading a link
+	// does not touch its reference count; copy the result only when the node must be kept alive.
+	const NodeUnit& getLeftChildPtr() const;
+	const NodeUnit& getRightChildPtr() const;
+
+	// Borrowed links for read-only walks. The child stays owned by this node.
+	BinaryUnit* getLeftChild() const;
+	BinaryUnit* getRightChild() const;
 
 	NodeUnit& getLeftChildPtrReference();
 	NodeUnit& getRightChildPtrReference();
 
 	void setLeftChildPtr(NodeUnit leftPtr);
 	void setRightChildPtr(NodeUnit rightPtr);
+
+	int getBalanceData() const;
+	void setBalanceData(int newBalanceData);
+
+	// Cached subtree height and node count. They are refreshed whenever a child pointer is set,
+	// so a caller that relinks a node deeper in the tree must also refresh the ancestors.
+	int getHeight() const;
+	int getNodeCount() const;
+	void updateSubtreeInfo();
 }; // end BinaryNode
 
 template<class ItemType>
-BinaryNode<ItemType>::BinaryNode() {}
+BinaryNode<ItemType>::BinaryNode() : balanceData(0), height(1), nodeCount(1) {}
+
+template<class ItemType>
+BinaryNode<ItemType>::BinaryNode(const ItemType& anItem) : item(anItem), balanceData(0), height(1), nodeCount(1) {}
 
 template<class ItemType>
-BinaryNode<ItemType>::BinaryNode(const ItemType& anItem) : item(anItem) {}
+BinaryNode<ItemType>::BinaryNode(ItemType&& anItem) : item(std::move(anItem)), balanceData(0), height(1), nodeCount(1) {}
+
+template<class ItemType>
+template<class... Args>
+BinaryNode<ItemType>::BinaryNode(std::piecewise_construct_t, Args&&... args) :
+	item(std::forward<Args>(args)...),
+	balanceData(0),
+	height(1),
+	nodeCount(1)
+{
+}
 
 template<class ItemType>
 BinaryNode<ItemType>::BinaryNode(const ItemType& anItem, NodeUnit leftPtr, NodeUnit rightPtr) :
 	item(anItem),
-	leftChildPtr(leftPtr),
-	rightChildPtr(rightPtr)
-{}
+	leftChildPtr(std::move(leftPtr)),
+	rightChildPtr(std::move(rightPtr)),
+	balanceData(0)
+{
+	updateSubtreeInfo();
+}
 
 template<class ItemType>
 void BinaryNode<ItemType>::setItem(const ItemType& anItem)
@@ -54,7 +97,19 @@ void BinaryNode<ItemType>::setItem(const ItemType& anItem)
 }
 
 template<class ItemType>
-ItemType BinaryNode<ItemType>::getItem() const
+void BinaryNode<ItemType>::setItem(ItemType&& anItem)
+{
+	item = std::move(anItem);
+}
+
+template<class ItemType>
+const ItemType& BinaryNode<ItemType>::getItem() const
+{
+	return item;
+}
+
+template<class ItemType>
+ItemType& BinaryNode<ItemType>::getItemReference()
 {
 	return item;
 }
@@ -62,27 +117,41 @@ ItemType BinaryNode<ItemType>::getItem() const
 template<class ItemType>
 void BinaryNode<ItemType>::setLeftChildPtr(NodeUnit leftPtr)
 {
-	leftChildPtr = leftPtr;
+	leftChildPtr = std::move(leftPtr);
+	updateSubtreeInfo();
 }
 
 template<class ItemType>
 void BinaryNode<ItemType>::setRightChildPtr(NodeUnit rightPtr)
 {
-	rightChildPtr = rightPtr;
+	rightChildPtr = std::move(rightPtr);
+	updateSubtreeInfo();
 }
 
 template<class ItemType>
-NodeUnit BinaryNode<ItemType>::getLeftChildPtr() const
+const NodeUnit& BinaryNode<ItemType>::getLeftChildPtr() const
 {
 	return leftChildPtr;
 }
 
 template<class ItemType>
-NodeUnit BinaryNode<ItemType>::getRightChildPtr() const
+const NodeUnit& BinaryNode<ItemType>::getRightChildPtr() const
 {
 	return rightChildPtr;
 }
 
+template<class ItemType>
+BinaryUnit* BinaryNode<ItemType>::getLeftChild() const
+{
+	return leftChildPtr.get();
+}
+
+template<class ItemType>
+BinaryUnit* BinaryNode<ItemType>::getRightChild() const
+{
+	return rightChildPtr.get();
+}
+
 template<class ItemType>
 NodeUnit& BinaryNode<ItemType>::getLeftChildPtrReference()
 {
@@ -95,6 +164,42 @@ NodeUnit& BinaryNode<ItemType>::getRightChildPtrReference()
 	return rightChildPtr;
 }
 
+template<class ItemType>
+int BinaryNode<ItemType>::getBalanceData() const
+{
+	return balanceData;
+}
+
+template<class ItemType>
+void BinaryNode<ItemType>::setBalanceData(int newBalanceData)
+{
+	balanceData = newBalanceData;
+}
+
+template<class ItemType>
+int BinaryNode<ItemType>::getHeight() const
+{
+	return height;
+}
+
+template<class ItemType>
+int BinaryNode<ItemType>::getNodeCount() const
+{
+	return nodeCount;
+}
+
+template<class ItemType>
+void BinaryNode<ItemType>::updateSubtreeInfo()
+{
+	int leftHeight = (leftChildPtr == nullptr) ? 0 : leftChildPtr->height;
+	int rightHeight = (rightChildPtr == nullptr) ? 0 : rightChildPtr->height;
+	int leftCount = (leftChildPtr == nullptr) ? 0 : leftChildPtr->nodeCount;
+	int rightCount = (rightChildPtr == nullptr) ? 0 : rightChildPtr->nodeCount;
+
+	height = 1 + max(leftHeight, rightHeight);
+	nodeCount = 1 + leftCount + rightCount;
+}
+
 template<class ItemType>
 bool BinaryNode<ItemType>::isLeaf() const
 {
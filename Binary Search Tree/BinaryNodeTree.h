@@ -5,59 +5,153 @@
 #include "BinaryNode.h"
 #include "PrecondViolatedExcept.h"
 #include "NotFoundException.h"
+#include "NodePool.h"
+#include "TraversalStack.h"
+#include "RingQueue.h"
+#include "WorkStealingPool.h"
+#include <type_traits>
+#include <thread>
+#include <exception>
 
 using namespace std;
 
-template<class ItemType>
+// NodeAllocator : std::allocator (the default) or NodePoolAllocator (see NodePool.h).
+template<class ItemType, class NodeAllocator = std::allocator<BinaryNode<ItemType> > >
 class BinaryNodeTree : public BinaryTreeInterface<ItemType>
 {
 private:
 	NodeUnit rootPtr;
+	NodeAllocator nodeAllocator;
 
 protected:
 	//------------------------------------------------------------
 	// Protected Utility Methods Section:
 	// Recursive helper methods for the public methods.
 	//------------------------------------------------------------
-	static int getHeightHelper(NodeUnit subTreePtr);
-	static int getNumberOfNodesHelper(NodeUnit subTreePtr);
+	static int getHeightHelper(const NodeUnit& subTreePtr);
+	static int getNumberOfNodesHelper(const NodeUnit& subTreePtr);
 
 	// Recursively adds a new node to the tree in a left/right fashion to keep tree balanced.
-	static NodeUnit balancedAdd(NodeUnit subTreePtr, NodeUnit newNodePtr);
+	static BinaryUnit* balancedAdd(BinaryUnit* subTreePtr, NodeUnit newNodePtr);
 
-	// Removes the target value from the tree.
-	virtual NodeUnit removeValue(NodeUnit &subTreePtr, const ItemType target, bool& isSuccessful);
+	// Removes the target value from the tree. The last node's item takes its place, keeping the level-filled shape.
+	virtual NodeUnit removeValue(NodeUnit &subTreePtr, const ItemType& target, bool& isSuccessful);
 
-	// Recursively searches for target value.
-	virtual NodeUnit findNode(NodeUnit treePtr, const ItemType& target, bool& isSuccessful) const;
+	// Searches for target value in preorder, with an explicit stack.
+	virtual NodeUnit findNode(const NodeUnit& treePtr, const ItemType& target, bool& isSuccessful) const;
 
-	// Copies the tree rooted at treePtr and returns a pointer to the root of the copy.
-	NodeUnit copyTree(const NodeUnit oldTreeRootPtr);
+	// Replaces this tree with a copy of the tree rooted at oldTreeRootPtr and returns the new root.
+	NodeUnit copyTree(const NodeUnit& oldTreeRootPtr);
 
-	// Recursively deletes all nodes from the tree.
-	static void destroyTree(NodeUnit &subTreePtr);
-	static void getNodeCollection(const NodeUnit root_ptr, vector<ItemType> &collection);
-
-	NodeUnit getRoot() const { return rootPtr; }
-
-	static bool accessUncompletedNode(NodeUnit root_ptr, NodeUnit &result_ptr, int height, int current_height, ItemType newItem);
-	static bool accessBalancedUncompletedNode(NodeUnit root_ptr, int height, int current_height, NodeUnit& result_ptr);
-	static bool accessBalancedUncompletedNodeHelper(NodeUnit root_ptr, int height, int target_height, int current_height, NodeUnit& result_ptr);
-	static bool accessLeftBalancedNode(NodeUnit root_ptr, int height, int current_height, NodeUnit& result_ptr);
+	// Copies the tree rooted at oldTreeRootPtr node for node, keeping its shape and each node's balance data,
+	// so the copy takes O(n) and no entry is placed again. Subtrees of parallelCloneThreshold nodes or more
+	// copy their left half as a task of the default WorkStealingPool, parallelDepth levels down at most.
+	NodeUnit cloneTree(const BinaryUnit* oldTreeRootPtr, int parallelDepth);
 
-	static int countNumNode(NodeUnit root_ptr);
-	static int determineNodeCount(int height);
+	// Copies the tree rooted at oldTreeRootPtr on the calling thread, without recursion.
+	NodeUnit cloneSubtree(const BinaryUnit* oldTreeRootPtr);
+	NodeUnit cloneNode(const BinaryUnit* oldNodePtr);
 
-	static NodeUnit copyTreeHelper(NodeUnit &root_ptr, const NodeUnit oldTreeRootPtr);
+	// How many levels of cloneTree may fork : enough to give every hardware thread a subtree.
+	static int parallelCloneDepth();
 
-	// Recursive traversal helper methods:
-	static void preorder(void visit(ItemType&), NodeUnit treePtr);
-	static void inorder(void visit(ItemType&), NodeUnit treePtr);
-	static void postorder(void visit(ItemType&), NodeUnit treePtr);
-	static void generalOrder(void visit(ItemType&), NodeUnit treePtr, int height, int current_height);
-	static void linearOrder(void visit(ItemType&), NodeUnit treePtr, int height, int current_height);
+	// Deletes all nodes from the tree, one node at a time so that deep trees do not exhaust the stack.
+	static void destroyTree(NodeUnit &subTreePtr);
 
-	static void collectNodeHeight(NodeUnit treePtr, vector<ItemType> &collection, int height, int target_height, int current_height);
+	// Allocates a node, with its shared_ptr control block, from the tree's allocator.
+	// The arguments are forwarded to a BinaryNode constructor.
+	template<class... Args>
+	NodeUnit createNode(Args&&... args);
+	static void getNodeCollection(const BinaryUnit* root_ptr, vector<ItemType> &collection);
+
+	const NodeUnit& getRoot() const { return rootPtr; }
+	NodeAllocator& getNodeAllocatorReference() { return nodeAllocator; }
+	NodeUnit& getRootReference() { return rootPtr; }
+
+	// Returns the parent of the node at the given insertion position (2 or more) of the level-filled tree
+	// rooted at root_ptr, in O(log n). path receives the ancestors of that parent, root first.
+	static BinaryUnit* accessParentOfPosition(BinaryUnit* root_ptr, int position, vector<BinaryUnit*>& path);
+
+	// Links a new node into the next free slot of the level-filled tree rooted at root_ptr, in O(log n).
+	static void addToCompleteTree(NodeUnit &root_ptr, NodeUnit newNodePtr);
+
+	// Unlinks the last node of the level-filled tree rooted at root_ptr and returns it, in O(log n).
+	static NodeUnit removeLastNode(NodeUnit &root_ptr);
+
+	static int countNumNode(const NodeUnit& root_ptr);
+
+	static const int parallelCloneThreshold = 1 << 15;
+
+	// NodePoolAllocator is not thread safe, so trees using it always copy and build on the calling thread.
+	static const bool canAllocateInParallel = std::is_same<NodeAllocator, std::allocator<BinaryUnit> >::value;
+
+	// Traversal helper methods. They only read the tree, so they walk borrowed links with an explicit stack.
+	static void preorder(void visit(ItemType&), const BinaryUnit* treePtr);
+	static void inorder(void visit(ItemType&), const BinaryUnit* treePtr);
+	static void postorder(void visit(ItemType&), const BinaryUnit* treePtr);
+	static void generalOrder(void visit(ItemType&), const BinaryUnit* treePtr);
+	static void linearOrder(void visit(ItemType&), const BinaryUnit* treePtr);
+
+	// Calls visit on the stored item and tells whether the traversal goes on :
+	// a visitor returning void always goes on, and one returning bool stops the traversal by returning false.
+	template<class Visitor>
+	static bool visitItem(Visitor& visit, const ItemType& item, std::true_type /* returns void */);
+	template<class Visitor>
+	static bool visitItem(Visitor& visit, const ItemType& item, std::false_type /* returns bool */);
+	template<class Visitor>
+	static bool visitItem(Visitor& visit, const ItemType& item);
+
+	// Calls visitItem for a Morris walk. If the visitor throws, the exception is kept in visitError and the
+	// visits stop, so that the walk can go on restoring the threaded links before the exception is rethrown.
+	template<class Visitor>
+	static bool visitThreaded(Visitor& visit, const ItemType& item, std::exception_ptr& visitError);
+
+	// Helper methods for the callable traversals, one per TraversalMode (see TraversalStack.h).
+	// They return false once the visitor stops.
+	template<class Visitor>
+	static bool preorderVisit(Visitor& visit, const BinaryUnit* treePtr);
+	template<class Visitor>
+	static bool inorderVisit(Visitor& visit, const BinaryUnit* treePtr);
+	template<class Visitor>
+	static bool postorderVisit(Visitor& visit, const BinaryUnit* treePtr);
+
+	template<class Visitor>
+	static bool preorderIterative(Visitor& visit, const BinaryUnit* treePtr);
+	template<class Visitor>
+	static bool inorderIterative(Visitor& visit, const BinaryUnit* treePtr);
+	template<class Visitor>
+	static bool postorderIterative(Visitor& visit, const BinaryUnit* treePtr);
+
+	template<class Visitor>
+	static bool preorderMorris(Visitor& visit, BinaryUnit* treePtr);
+	template<class Visitor>
+	static bool inorderMorris(Visitor& visit, BinaryUnit* treePtr);
+
+	// Visits the node at the front of a breadth-first queue and queues its children.
+	template<class Visitor>
+	static bool visitQueued(Visitor& visit, RingQueue<const BinaryUnit*>& queue);
+
+	// Level-order walks in a single O(n) pass, streaming each item to the visitor as it is reached.
+	// The queues only hold one level at a time; they are passed in so that a caller can reuse them across walks.
+	template<class Visitor>
+	static bool generalOrderVisit(Visitor& visit, const BinaryUnit* treePtr,
+		RingQueue<const BinaryUnit*>& leftQueue, RingQueue<const BinaryUnit*>& rightQueue);
+	template<class Visitor>
+	static bool linearOrderVisit(Visitor& visit, const BinaryUnit* treePtr, RingQueue<const BinaryUnit*>& queue);
+
+	// Helper methods for parallelForEach and parallelReduce. A subtree of more than grainSize nodes hands its
+	// left subtree to the pool, handles its root and goes on with its right subtree; smaller ones are walked
+	// by the task that reaches them.
+	template<class Visitor>
+	static void parallelVisit(Visitor& visit, const BinaryUnit* treePtr, int grainSize, WorkStealingPool& pool);
+	template<class Result, class Accumulate, class Combine>
+	static Result parallelReduceHelper(const BinaryUnit* treePtr, const Result& identity, Accumulate& accumulate,
+		Combine& combine, int grainSize, WorkStealingPool& pool);
+
+	// Whether the subtree is worth splitting : it is larger than grainSize and not much taller than a balanced
+	// tree of its size. A taller one (a chain of an unbalanced tree) gains nothing from splitting, and would
+	// nest one task per level.
+	static bool isWorthSplitting(const BinaryUnit* treePtr, int grainSize);
 
 public:
 	//------------------------------------------------------------
@@ -67,6 +161,11 @@ public:
 	BinaryNodeTree(const ItemType& rootItem);
 	BinaryNodeTree(const ItemType& rootItem, const NodeUnit leftTreePtr, const NodeUnit rightTreePtr);
 	BinaryNodeTree(const NodeUnit& tree);
+	BinaryNodeTree(const BinaryNodeTree& tree);
+
+	// Takes over the nodes of tree, which is left empty. The nodes keep coming from the allocator they were
+	// made with, which both trees then share.
+	BinaryNodeTree(BinaryNodeTree&& tree) noexcept;
 	virtual ~BinaryNodeTree();
 
 	//------------------------------------------------------------
@@ -80,7 +179,16 @@ public:
 	void setRootData(const ItemType& newData) throw(PrecondViolatedExcept);
 
 	bool add(const ItemType& newData); // Adds an item to the tree
+	bool add(ItemType&& newData);
+
+	// Adds an item constructed in place from args.
+	template<class... Args>
+	bool emplace(Args&&... args);
 	bool remove(const ItemType& data); // Removes specified item from the tree
+
+	// Removes every item in O(n) : each node is destroyed, iteratively, since its control block holds a copy
+	// of the allocator. With a NodePoolAllocator the chunks then go back to the system at once instead of
+	// node by node, which saves the n frees but not the walk.
 	void clear();
 
 	ItemType getEntry(const ItemType& anEntry) const throw(NotFoundException);
@@ -95,100 +203,148 @@ public:
 	void generalOrderTraverse(void visit(ItemType&)) const; // The original order of the data
 	void linearOrderTraverse(void visit(ItemType&)) const;    // Another way of displaying data
 
+	// The same traversals for any callable taking const ItemType&, which gets the stored item itself.
+	// A visitor returning bool ends the traversal early by returning false.
+	// The depth-first orders can pick how they walk the tree (see TraversalStack.h).
+	// TraversalMode::Morris writes to the nodes despite const : it threads links through the tree for the
+	// duration of the walk, so nothing else may read the tree meanwhile (no other traversal, iterator or
+	// parallelForEach, nor a snapshot sharing the nodes). The links are restored even if the visitor throws.
+	// @return  False if the visitor stopped the traversal, or true if every node was visited.
+	template<class Visitor>
+	bool preorderTraverse(Visitor visit, TraversalMode mode = TraversalMode::Iterative) const;
+	template<class Visitor>
+	bool inorderTraverse(Visitor visit, TraversalMode mode = TraversalMode::Iterative) const;
+	template<class Visitor>
+	bool postorderTraverse(Visitor visit, TraversalMode mode = TraversalMode::Iterative) const;
+	template<class Visitor>
+	bool generalOrderTraverse(Visitor visit) const;
+	template<class Visitor>
+	bool linearOrderTraverse(Visitor visit) const;
+
+	//------------------------------------------------------------
+	// Public Parallel Section.
+	// The work is split at subtree boundaries, using the cached node counts, onto a work-stealing pool.
+	// A subtree of grainSize nodes or fewer is walked by a single task.
+	//------------------------------------------------------------
+	static const int defaultGrainSize = 1 << 13;
+
+	// Calls visit on every entry, from several threads at once and in no particular order.
+	// visit takes const ItemType& and must be safe to call concurrently; its return value is ignored.
+	// If visit throws, the first exception is rethrown once every task has finished.
+	template<class Visitor>
+	void parallelForEach(Visitor visit, int grainSize = defaultGrainSize,
+		WorkStealingPool& pool = WorkStealingPool::getDefault()) const;
+
+	// Folds the entries in inorder. Each task starts from a copy of identity and adds its entries with
+	// accumulate(Result&, const ItemType&); the results of adjacent subtrees are merged with
+	// combine(Result& left, const Result& right). Both are called from several threads at once, and combine
+	// must be associative, so that the result does not depend on how the tree was split.
+	template<class Result, class Accumulate, class Combine>
+	Result parallelReduce(const Result& identity, Accumulate accumulate, Combine combine,
+		int grainSize = defaultGrainSize, WorkStealingPool& pool = WorkStealingPool::getDefault()) const;
+
+	// The allocator nodes come from (NodePoolAllocator reports its allocation counts and bytes).
+	const NodeAllocator& getNodeAllocator() const { return nodeAllocator; }
+
 															  //------------------------------------------------------------
 															  // Overloaded Operator Section.
 															  //------------------------------------------------------------
 	BinaryNodeTree& operator=(const BinaryNodeTree& rightHandSide);
+	BinaryNodeTree& operator=(BinaryNodeTree&& rightHandSide) noexcept;
 
 }; // end BinaryNodeTree
 
    // -------------------Definitons----------------------------
-template<class ItemType>
-BinaryNodeTree<ItemType>::BinaryNodeTree() {}
+template<class ItemType, class NodeAllocator>
+BinaryNodeTree<ItemType, NodeAllocator>::BinaryNodeTree() {}
 
-template<class ItemType>
-BinaryNodeTree<ItemType>::~BinaryNodeTree() {}
+template<class ItemType, class NodeAllocator>
+BinaryNodeTree<ItemType, NodeAllocator>::~BinaryNodeTree()
+{
+	destroyTree(rootPtr);
+}
 
-template<class ItemType>
-BinaryNodeTree<ItemType>::BinaryNodeTree(const ItemType& rootItem)
+template<class ItemType, class NodeAllocator>
+BinaryNodeTree<ItemType, NodeAllocator>::BinaryNodeTree(const ItemType& rootItem)
 {
 	add(rootItem);
 }
 
-template<class ItemType>
-BinaryNodeTree<ItemType>::BinaryNodeTree(const ItemType& rootItem, const NodeUnit leftTreePtr, const NodeUnit rightTreePtr)
+template<class ItemType, class NodeAllocator>
+BinaryNodeTree<ItemType, NodeAllocator>::BinaryNodeTree(const ItemType& rootItem, const NodeUnit leftTreePtr, const NodeUnit rightTreePtr)
 {
 	add(rootItem);
-	copyTree(rootPtr->getLeftChildPtrReference());
-	copyTree(rootPtr->getRightChildPtrReference());
+	rootPtr->setLeftChildPtr(cloneTree(leftTreePtr.get(), parallelCloneDepth()));
+	rootPtr->setRightChildPtr(cloneTree(rightTreePtr.get(), parallelCloneDepth()));
+}
+
+template<class ItemType, class NodeAllocator>
+BinaryNodeTree<ItemType, NodeAllocator>::BinaryNodeTree(const BinaryNodeTree<ItemType, NodeAllocator>& tree)
+{
+	copyTree(tree.getRoot());
 }
 
-template<class ItemType>
-BinaryNodeTree<ItemType>& BinaryNodeTree<ItemType>::operator = (const BinaryNodeTree<ItemType>& rightHandSide)
+template<class ItemType, class NodeAllocator>
+BinaryNodeTree<ItemType, NodeAllocator>::BinaryNodeTree(BinaryNodeTree<ItemType, NodeAllocator>&& tree) noexcept :
+	rootPtr(std::move(tree.rootPtr)),
+	nodeAllocator(tree.nodeAllocator)
+{
+}
+
+template<class ItemType, class NodeAllocator>
+BinaryNodeTree<ItemType, NodeAllocator>& BinaryNodeTree<ItemType, NodeAllocator>::operator = (const BinaryNodeTree<ItemType, NodeAllocator>& rightHandSide)
 {
 	if (&rightHandSide != this)
 	{
-		copyTree(rootPtr, rightHandSide.getRoot());
+		copyTree(rightHandSide.getRoot());
 	}
 
 	return (*this);
 }
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::collectNodeHeight(NodeUnit treePtr, vector<ItemType> &collection, int height, int target_height, int current_height)
+template<class ItemType, class NodeAllocator>
+BinaryNodeTree<ItemType, NodeAllocator>& BinaryNodeTree<ItemType, NodeAllocator>::operator = (BinaryNodeTree<ItemType, NodeAllocator>&& rightHandSide) noexcept
 {
-	if (treePtr.get() == nullptr)
-	{return;}
-
-	NodeUnit leftPtr = treePtr->getLeftChildPtr();
-	NodeUnit rightPtr = treePtr->getRightChildPtr();
-
-	if (target_height == current_height)
-	{
-		if (leftPtr.get() != nullptr)
-		{
-			collection.push_back(leftPtr->getItem());
-		}
-
-		if (rightPtr.get() != nullptr)
-		{
-			collection.push_back(rightPtr->getItem());
-		}
-		return;
-	}
-	else
+	if (&rightHandSide != this)
 	{
-		collectNodeHeight(leftPtr, collection, height, target_height, current_height + 1);
-		collectNodeHeight(rightPtr, collection, height, target_height, current_height + 1);
+		destroyTree(rootPtr);
+		rootPtr = std::move(rightHandSide.rootPtr);
+		nodeAllocator = rightHandSide.nodeAllocator;
 	}
-}
 
+	return (*this);
+}
 
 // Recursively searches for target value.
-template<class ItemType>
-NodeUnit BinaryNodeTree<ItemType>::findNode(NodeUnit treePtr, const ItemType& target, bool& isSuccessful) const
+template<class ItemType, class NodeAllocator>
+NodeUnit BinaryNodeTree<ItemType, NodeAllocator>::findNode(const NodeUnit& treePtr, const ItemType& target, bool& isSuccessful) const
 {
 	isSuccessful = false;
-	if (treePtr.get() == nullptr)
-	{
-		return treePtr;
-	}
 
-	if (treePtr->getItem() == target)
+	SmallStack<const NodeUnit*> pendingLinks;
+	if (treePtr.get() != nullptr) pendingLinks.push(&treePtr);
+
+	while (!pendingLinks.isEmpty())
 	{
-		isSuccessful = true;
-		return treePtr;
-	}
+		const NodeUnit& nodePtr = *pendingLinks.peek();
+		pendingLinks.pop();
+
+		if (nodePtr->getItem() == target)
+		{
+			isSuccessful = true;
+			return nodePtr;
+		}
 
-	NodeUnit leftPtr = treePtr->getLeftChildPtr();
-	NodeUnit rightPtr = treePtr->getRightChildPtr();
+		// Right first, so that the left subtree is searched first
+		if (nodePtr->getRightChild() != nullptr) pendingLinks.push(&nodePtr->getRightChildPtr());
+		if (nodePtr->getLeftChild() != nullptr) pendingLinks.push(&nodePtr->getLeftChildPtr());
+	}
 
-	if (findNode(leftPtr, target, isSuccessful).get() != nullptr) return leftPtr;
-	return findNode(rightPtr, target, isSuccessful);
+	return NodeUnit();
 }
 
-template<class ItemType>
-ItemType BinaryNodeTree<ItemType>::getEntry(const ItemType& anEntry) const throw(NotFoundException)
+template<class ItemType, class NodeAllocator>
+ItemType BinaryNodeTree<ItemType, NodeAllocator>::getEntry(const ItemType& anEntry) const throw(NotFoundException)
 {
 	bool isSuccessful;
 	findNode(rootPtr, anEntry, isSuccessful);
@@ -197,8 +353,8 @@ ItemType BinaryNodeTree<ItemType>::getEntry(const ItemType& anEntry) const throw
 	throw NotFoundException("BinaryNodeTree::getEntry : Entry not found");
 }
 
-template<class ItemType>
-bool BinaryNodeTree<ItemType>::contains(const ItemType& anEntry) const
+template<class ItemType, class NodeAllocator>
+bool BinaryNodeTree<ItemType, NodeAllocator>::contains(const ItemType& anEntry) const
 {
 	bool isSuccessful;
 	findNode(rootPtr, anEntry, isSuccessful);
@@ -209,81 +365,46 @@ bool BinaryNodeTree<ItemType>::contains(const ItemType& anEntry) const
 		return false;
 }
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::linearOrder(void visit(ItemType&), NodeUnit treePtr, int height, int current_height)
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::linearOrder(void visit(ItemType&), const BinaryUnit* treePtr)
 {
-	int i;
-	if (treePtr.get() == nullptr)
+	if (treePtr == nullptr)
 	{
 		cout << "BinaryNodeTree::linearOrder()\n+ Fatal error : The treePtr argument cannot be null\n";
 		system("pause");
 		terminate();
 	}
 
-	vector<ItemType> itemCollection;
-
-	for (i = 2; i <= height; i++)
-		collectNodeHeight(treePtr, itemCollection, height, i, 2);
-
-	ItemType myItem = treePtr->getItem(); visit(myItem);
+	// The visitor may change its argument, so it gets a copy of each item
+	auto visitCopy = [visit](const ItemType& item) { ItemType theItem = item; visit(theItem); };
 
-	for (i = 0; i < (int)itemCollection.size(); i++)
-	{
-		visit(itemCollection[i]);
-	}
+	RingQueue<const BinaryUnit*> queue;
+	linearOrderVisit(visitCopy, treePtr, queue);
 }
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::getNodeCollection(const NodeUnit root_ptr, vector<ItemType> &collection)
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::getNodeCollection(const BinaryUnit* root_ptr, vector<ItemType> &collection)
 {
-	int i;
-	if (root_ptr.get() == nullptr)
+	if (root_ptr == nullptr)
 	{
 		cout << "BinaryNodeTree::getNodeCollection()\n+ Fatal error : The root_ptr argument cannot be null\n";
 		system("pause");
 		terminate();
 	}
 
-	int height = getHeightHelper(root_ptr);
-
 	collection.clear();
-	vector<ItemType> leftNodeCollection;
-	vector<ItemType> rightNodeCollection;
-
-	NodeUnit leftPtr = root_ptr->getLeftChildPtr();
-	NodeUnit rightPtr = root_ptr->getRightChildPtr();
-
-	if (leftPtr.get() != nullptr)
-	{
-		leftNodeCollection.push_back(leftPtr->getItem());
-
-		for (i = 3; i <= height; i++)
-			collectNodeHeight(leftPtr, leftNodeCollection, height, i, 3);
-	}
-
-	if (rightPtr.get() != nullptr)
-	{
-		rightNodeCollection.push_back(rightPtr->getItem());
-
-		for (i = 3; i <= height; i++)
-			collectNodeHeight(rightPtr, rightNodeCollection, height, i, 3);
-	}
-
-	int len_max = max(leftNodeCollection.size(), rightNodeCollection.size());
+	collection.reserve(root_ptr->getNodeCount());
 
-	collection.push_back(root_ptr->getItem());
+	auto appendItem = [&collection](const ItemType& item) { collection.push_back(item); };
 
-	for (i = 0; i < len_max; i++)
-	{
-		if (i < leftNodeCollection.size()) collection.push_back(leftNodeCollection[i]);
-		if (i < rightNodeCollection.size()) collection.push_back(rightNodeCollection[i]);
-	}
+	RingQueue<const BinaryUnit*> leftQueue, rightQueue;
+	generalOrderVisit(appendItem, root_ptr, leftQueue, rightQueue);
 }
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::generalOrder(void visit(ItemType&), NodeUnit treePtr, int height, int current_height)
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::generalOrder(void visit(ItemType&), const BinaryUnit* treePtr)
 {
-	if (treePtr.get() == nullptr)
+	if (treePtr == nullptr)
 	{
 		cout << "BinaryNodeTree::generalOrder()\n+ Fatal error : The treePtr argument cannot be null\n";
 		system("pause"); 
@@ -298,544 +419,837 @@ void BinaryNodeTree<ItemType>::generalOrder(void visit(ItemType&), NodeUnit tree
 	//            [8]           [10]        [12]           [14]             [9]             [11]         [13]               [15]        // Height : 2 (4)
 	//        [16][18]    [20][22]   [24][26]     [28][30]        [17][19]       [21][23]    [25][27]        [29][31]     // Height : 1 (5)
 
-	// Use the regular recursion method - two vectors for two parts
+	// Each part is filled in level order, and the insertion order takes one node from each part in turn
 	// Root : 1
 	// Even : 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30
 	// Odd : 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31
-	// Calculate height in advance too 
+	// So one breadth-first walk per part, interleaved, gives the insertion order in a single pass
 
-	int i;
-	vector<ItemType> leftNodeCollection;
-	vector<ItemType> rightNodeCollection;
+	auto visitCopy = [visit](const ItemType& item) { ItemType theItem = item; visit(theItem); };
 
-	NodeUnit leftPtr = treePtr->getLeftChildPtr();
-	NodeUnit rightPtr = treePtr->getRightChildPtr();
+	RingQueue<const BinaryUnit*> leftQueue, rightQueue;
+	generalOrderVisit(visitCopy, treePtr, leftQueue, rightQueue);
+} // End generalOrder()
 
-	if (leftPtr.get() != nullptr)
-	{
-		leftNodeCollection.push_back(leftPtr->getItem());
 
-		for (i = 3; i <= height; i++)
-			collectNodeHeight(leftPtr, leftNodeCollection, height, i, 3);
-	}
+template<class ItemType, class NodeAllocator>
+int BinaryNodeTree<ItemType, NodeAllocator>::getNumberOfNodesHelper(const NodeUnit& subTreePtr)
+{
+	return countNumNode(subTreePtr);
+}
 
-	if (rightPtr.get() != nullptr)
-	{
-		rightNodeCollection.push_back(rightPtr->getItem());
+template<class ItemType, class NodeAllocator>
+int BinaryNodeTree<ItemType, NodeAllocator>::countNumNode(const NodeUnit& root_ptr)
+{
+	// The node count is cached in every node
+	if (root_ptr.get() == nullptr)
+		return 0;
+	else
+		return root_ptr->getNodeCount();
+}
 
-		for (i = 3; i <= height; i++)
-			collectNodeHeight(rightPtr, rightNodeCollection, height, i, 3);
-	}
+template<class ItemType, class NodeAllocator>
+bool BinaryNodeTree<ItemType, NodeAllocator>::add(const ItemType& newData)
+{
+	addToCompleteTree(rootPtr, createNode(newData));
 
-	int len_max = max(leftNodeCollection.size(), rightNodeCollection.size());
+	return true;
+} // end add
 
-	ItemType myItem = treePtr->getItem();
-	visit(myItem);
+template<class ItemType, class NodeAllocator>
+bool BinaryNodeTree<ItemType, NodeAllocator>::add(ItemType&& newData)
+{
+	addToCompleteTree(rootPtr, createNode(std::move(newData)));
 
-	for (i = 0; i < len_max; i++)
-	{
-		if (i < leftNodeCollection.size()) visit(leftNodeCollection[i]);
-		if (i < rightNodeCollection.size()) visit(rightNodeCollection[i]);
-	}
+	return true;
+}
 
-} // End generalOrder()
+template<class ItemType, class NodeAllocator>
+template<class... Args>
+bool BinaryNodeTree<ItemType, NodeAllocator>::emplace(Args&&... args)
+{
+	addToCompleteTree(rootPtr, createNode(std::piecewise_construct, std::forward<Args>(args)...));
 
+	return true;
+}
 
-template<class ItemType>
-int BinaryNodeTree<ItemType>::determineNodeCount(int height)
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::addToCompleteTree(NodeUnit &root_ptr, NodeUnit newNodePtr)
 {
-	int i;
-	int totalNodeCount = 0;
-	for (i = 0; i < height; i++)
+	if (root_ptr.get() == nullptr)
 	{
-		totalNodeCount += pow(2, i);
+		root_ptr = newNodePtr;
+		return;
 	}
 
-	return totalNodeCount;
-}
+	vector<BinaryUnit*> path;
+	BinaryUnit* parentPtr = accessParentOfPosition(root_ptr.get(), root_ptr->getNodeCount() + 1, path);
+
+	// The last bit picks the slot, which is always the first free one of the parent
+	balancedAdd(parentPtr, std::move(newNodePtr));
+
+	// The parent was refreshed when its child was set; its ancestors follow bottom-up
+	for (int i = (int)path.size() - 1; i >= 0; i--)
+		path[i]->updateSubtreeInfo();
+} // End addToCompleteTree()
 
-template<class ItemType>
-int BinaryNodeTree<ItemType>::getNumberOfNodesHelper(NodeUnit subTreePtr)
+template<class ItemType, class NodeAllocator>
+BinaryUnit* BinaryNodeTree<ItemType, NodeAllocator>::accessParentOfPosition(BinaryUnit* root_ptr, int position, vector<BinaryUnit*>& path)
 {
-	return countNumNode(subTreePtr);
-}
+	// The slot is fully determined by the position (see the examples in TopicD.cpp).
+	// With the root at position 1, even positions fill the left subtree and odd positions the right one,
+	// each in level order. Position p is therefore entry p / 2 of its subtree in level order, and the bits
+	// of p / 2 after the leading one spell the path down that subtree : 0 = left, 1 = right.
+	int subTreePosition = position / 2;
+
+	int depth = 0;
+	while ((subTreePosition >> (depth + 1)) != 0) depth++;
+
+	BinaryUnit* parentPtr = root_ptr;
+
+	for (int step = 0; step < depth; step++)
+	{
+		bool goLeft = (step == 0) ? (position % 2 == 0) : (((subTreePosition >> (depth - step)) & 1) == 0);
+
+		path.push_back(parentPtr);
+		parentPtr = goLeft ? parentPtr->getLeftChild() : parentPtr->getRightChild();
+	}
 
-template<class ItemType>
-int BinaryNodeTree<ItemType>::countNumNode(NodeUnit root_ptr)
+	return parentPtr;
+} // End accessParentOfPosition()
+
+template<class ItemType, class NodeAllocator>
+NodeUnit BinaryNodeTree<ItemType, NodeAllocator>::removeLastNode(NodeUnit &root_ptr)
 {
-	int totalCount;
+	NodeUnit lastPtr;
 
 	if (root_ptr.get() == nullptr)
 	{
-		totalCount = 0;
+		return lastPtr;
 	}
-	else
+
+	if (root_ptr->isLeaf())
 	{
-		totalCount = 1;
+		lastPtr = root_ptr;
+		root_ptr = nullptr;
+		return lastPtr;
+	}
 
-		NodeUnit leftPtr = root_ptr->getLeftChildPtr();
-		NodeUnit rightPtr = root_ptr->getRightChildPtr();
+	vector<BinaryUnit*> path;
+	BinaryUnit* parentPtr = accessParentOfPosition(root_ptr.get(), root_ptr->getNodeCount(), path);
 
-		totalCount += countNumNode(leftPtr);
-		totalCount += countNumNode(rightPtr);
+	// The last node is the most recent child of its parent
+	if (parentPtr->getRightChildPtr().get() != nullptr)
+	{
+		lastPtr = parentPtr->getRightChildPtr();
+		parentPtr->setRightChildPtr(nullptr);
+	}
+	else
+	{
+		lastPtr = parentPtr->getLeftChildPtr();
+		parentPtr->setLeftChildPtr(nullptr);
 	}
 
-	return totalCount;
-}
+	for (int i = (int)path.size() - 1; i >= 0; i--)
+		path[i]->updateSubtreeInfo();
+
+	return lastPtr;
+} // End removeLastNode()
 
-template<class ItemType>
-bool BinaryNodeTree<ItemType>::accessBalancedUncompletedNodeHelper(NodeUnit root_ptr, int height, int target_height, int current_height, NodeUnit& result_ptr)
+template<class ItemType, class NodeAllocator>
+BinaryUnit* BinaryNodeTree<ItemType, NodeAllocator>::balancedAdd(BinaryUnit* subTreePtr, NodeUnit newNodePtr)
 {
-	if (root_ptr.get() == nullptr)
+	if (subTreePtr == nullptr)
 	{
-		cout << "BinaryNodeTree::accessBalancedUncompletedNodeHelper()\n+ Fatal error : The root_ptr argument cannot be null\n";
+		cout << "BinaryNodeTree::balancedAdd()\n+ Fatal error : The subTreePtr argument cannot be null\n";
 		system("pause");
 		terminate();
 	}
 
-	NodeUnit leftPtr = root_ptr->getLeftChildPtr();
-	NodeUnit rightPtr = root_ptr->getRightChildPtr();
-
-	if (target_height == current_height)
+	if (subTreePtr->getLeftChild() == nullptr)
 	{
-		if (leftPtr.get() == nullptr)
-		{
-			result_ptr = root_ptr;
-			return true;
-		}
+		subTreePtr->setLeftChildPtr(std::move(newNodePtr));
+	}
+	else if (subTreePtr->getRightChild() == nullptr)
+	{
+		subTreePtr->setRightChildPtr(std::move(newNodePtr));
+	}
 
-		if (rightPtr.get() == nullptr)
-		{
-			result_ptr = root_ptr;
-			return true;
-		}
+	return subTreePtr;
+} // End balancedAdd()
 
-		return false;
-	}
 
-	if (leftPtr.get() != nullptr)
-		if (accessBalancedUncompletedNodeHelper(leftPtr, height, target_height, current_height - 1, result_ptr)) return true;
+template<class ItemType, class NodeAllocator>
+int BinaryNodeTree<ItemType, NodeAllocator>::getHeightHelper(const NodeUnit& subTreePtr)
+{
+	// The height is cached in every node
+	if (subTreePtr == nullptr)
+		return 0;
+	else
+		return subTreePtr->getHeight();
+
+} // end getHeightHelper
 
-	if (rightPtr.get() != nullptr)
-		if (accessBalancedUncompletedNodeHelper(rightPtr, height, target_height, current_height - 1, result_ptr)) return true;
 
-	return false;
-}
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::postorder(void visit(ItemType&), const BinaryUnit* treePtr)
+{
+	// The visitor may change its argument, so it gets a copy of each item
+	auto visitCopy = [visit](const ItemType& item) { ItemType theItem = item; visit(theItem); };
+	postorderIterative(visitCopy, treePtr);
+} // End postorder()
 
 
-template<class ItemType>
-bool BinaryNodeTree<ItemType>::accessBalancedUncompletedNode(NodeUnit root_ptr, int height, int current_height, NodeUnit& result_ptr)
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::preorder(void visit(ItemType&), const BinaryUnit* treePtr)
 {
-	int i;
-	if (root_ptr.get() == nullptr)
-	{
-		cout << "BinaryNodeTree::accessBalancedUncompletedNode()\n+ Fatal error : The root_ptr argument cannot be null\n";
-		system("pause"); 
-		terminate();
-	}
+	auto visitCopy = [visit](const ItemType& item) { ItemType theItem = item; visit(theItem); };
+	preorderIterative(visitCopy, treePtr);
+} // End preorder()
 
-	NodeUnit leftPtr = root_ptr->getLeftChildPtr();
-	NodeUnit rightPtr = root_ptr->getRightChildPtr();
 
-	if (leftPtr.get() == nullptr || rightPtr.get() == nullptr)
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::inorder(void visit(ItemType&), const BinaryUnit* treePtr)
+{
+	auto visitCopy = [visit](const ItemType& item) { ItemType theItem = item; visit(theItem); };
+	inorderIterative(visitCopy, treePtr);
+} // End inorder()
+
+template<class ItemType, class NodeAllocator>
+NodeUnit BinaryNodeTree<ItemType, NodeAllocator>::removeValue(NodeUnit &subTreePtr, const ItemType& target, bool& isSuccessful)
+{
+	NodeUnit targetPtr = findNode(subTreePtr, target, isSuccessful);
+
+	if (!isSuccessful)
 	{
-		result_ptr = root_ptr;
-		return true;
+		return subTreePtr;
 	}
 
-	for (i = current_height - 1; i >= 2; i--)
-	{
-		if (leftPtr.get() != nullptr)
-			if (accessBalancedUncompletedNodeHelper(leftPtr, height, i, current_height - 1, result_ptr)) return true;
+	// Swap in the last node, then detach it : no node is allocated and the shape stays level-filled
+	NodeUnit lastPtr = removeLastNode(subTreePtr);
 
-		if (rightPtr.get() != nullptr)
-			if (accessBalancedUncompletedNodeHelper(rightPtr, height, i, current_height - 1, result_ptr)) return true;
+	if (lastPtr != targetPtr)
+	{
+		targetPtr->setItem(std::move(lastPtr->getItemReference()));
 	}
 
-	return false;
+	return subTreePtr;
 }
 
-template<class ItemType>
-bool BinaryNodeTree<ItemType>::accessLeftBalancedNode(NodeUnit root_ptr, int height, int current_height, NodeUnit& result_ptr)
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::destroyTree(NodeUnit &subTreePtr)
 {
-	if (root_ptr.get() == nullptr)
+	vector<NodeUnit> pendingNodes;
+	if (subTreePtr.get() != nullptr) pendingNodes.push_back(subTreePtr);
+	subTreePtr = nullptr;
+
+	while (!pendingNodes.empty())
 	{
-		cout << "BinaryNodeTree::accessLeftBalancedNode()\n+ Fatal error : The root_ptr argument cannot be null\n";
-		system("pause");
-		terminate();
-	}
+		NodeUnit nodePtr = std::move(pendingNodes.back());
+		pendingNodes.pop_back();
 
-	NodeUnit leftPtr = root_ptr->getLeftChildPtr();
+		// A node still referenced elsewhere keeps its subtree
+		if (nodePtr.use_count() > 1) continue;
 
-	if (leftPtr.get() == nullptr)
-	{
-		result_ptr = root_ptr;
-		return true;
-	}
+		NodeUnit& leftPtr = nodePtr->getLeftChildPtrReference();
+		NodeUnit& rightPtr = nodePtr->getRightChildPtrReference();
 
-	if (leftPtr.get() != nullptr)
-		return accessLeftBalancedNode(leftPtr, height, current_height - 1, result_ptr);
+		// Moving the links out hands them over without touching their reference counts
+		if (leftPtr.get() != nullptr) pendingNodes.push_back(std::move(leftPtr));
+		if (rightPtr.get() != nullptr) pendingNodes.push_back(std::move(rightPtr));
 
-	return false;
+		leftPtr = nullptr;
+		rightPtr = nullptr;
+	} // The node is freed here, without children to release recursively
 }
 
-
-// You may use a pointer the catch the return value
-template<class ItemType>
-bool BinaryNodeTree<ItemType>::accessUncompletedNode(NodeUnit root_ptr, NodeUnit &result_ptr, int height, int current_height, ItemType newItem)
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::clear()
 {
-	// To determine which node is the right successor
+	destroyTree(rootPtr);
+	releaseNodeMemory(nodeAllocator);
+}
 
-	if (height == 0)
-	{
-		cout << "BinaryNodeTree::accessUncompletedNode()\n+ Fatal error : The height argument cannot be 0\n";
-		system("pause"); 
-		terminate();
-	}
+template<class ItemType, class NodeAllocator>
+template<class... Args>
+NodeUnit BinaryNodeTree<ItemType, NodeAllocator>::createNode(Args&&... args)
+{
+	return std::allocate_shared<BinaryUnit>(nodeAllocator, std::forward<Args>(args)...);
+}
 
-	if (root_ptr.get() == nullptr)
-	{
-		cout << "BinaryNodeTree::accessUncompletedNode()\n+ Fatal error : The root_ptr argument cannot be null\n";
-		system("pause");
-		terminate();
-	}
+template<class ItemType, class NodeAllocator>
+NodeUnit BinaryNodeTree<ItemType, NodeAllocator>::copyTree(const NodeUnit& oldTreeRootPtr)
+{
+	NodeUnit newRootPtr = cloneTree(oldTreeRootPtr.get(), parallelCloneDepth());
 
-	int halfCount = (determineNodeCount(current_height) - 1) / 2;
+	destroyTree(rootPtr);
+	rootPtr = std::move(newRootPtr);
 
-	NodeUnit leftPtr = root_ptr->getLeftChildPtr();
-	int nodeLeftCount = countNumNode(leftPtr);
+	return rootPtr;
+}
 
-	NodeUnit rightPtr = root_ptr->getRightChildPtr();
-	int nodeRightCount = countNumNode(rightPtr);
+template<class ItemType, class NodeAllocator>
+NodeUnit BinaryNodeTree<ItemType, NodeAllocator>::cloneTree(const BinaryUnit* oldTreeRootPtr, int parallelDepth)
+{
+	if (oldTreeRootPtr == nullptr) return NodeUnit();
 
-	if (height == 1)
-	{
-		result_ptr = root_ptr;
-		return true;
-	}
+	if (!canAllocateInParallel || parallelDepth <= 0 || oldTreeRootPtr->getNodeCount() < parallelCloneThreshold)
+		return cloneSubtree(oldTreeRootPtr);
 
-	// Algorithm : When detecting that there is a difference between nodeLeftCount and nodeRightCount
-	// if(nodeLeftCount < nodeRightCount) - Add an element to the left side (from left order) to balance the left side
-	// if(nodeRightCount < nodeLeftCount) - Add an element to the left side (from left order) to balance the right side
-	// if(nodeRightCount == nodeLeftCount) - Add an element to the left side (from left order)
+	NodeUnit newRootPtr = cloneNode(oldTreeRootPtr);
 
-	if (nodeLeftCount == nodeRightCount && nodeLeftCount == 0)
+	// The left subtree is copied by another task while this one copies the right subtree
+	NodeUnit leftCopy;
+	WorkStealingPool::TaskGroup group(WorkStealingPool::getDefault());
+	group.run([this, oldTreeRootPtr, parallelDepth, &leftCopy]()
 	{
-		result_ptr = root_ptr;
-		return true;
-	}
+		leftCopy = cloneTree(oldTreeRootPtr->getLeftChild(), parallelDepth - 1);
+	});
+	NodeUnit rightCopy = cloneTree(oldTreeRootPtr->getRightChild(), parallelDepth - 1);
+	group.wait();
 
-	if (nodeLeftCount < nodeRightCount)
-	{
-		if (leftPtr.get() == nullptr)
-		{
-			result_ptr = root_ptr;
-			return true;
-		}
+	newRootPtr->getLeftChildPtrReference() = std::move(leftCopy);
+	newRootPtr->setRightChildPtr(std::move(rightCopy)); // Refreshes the subtree info with both children in place
 
-		bool result = accessBalancedUncompletedNode(leftPtr, height, current_height - 1, result_ptr);
-		if (!result) { cout << "Abort A1F4\n"; abort(); }
+	return newRootPtr;
+} // End cloneTree()
 
-		return true;
-	}
-	else if (nodeRightCount < nodeLeftCount)
-	{
-		if (rightPtr.get() == nullptr)
-		{
-			result_ptr = root_ptr;
-			return true;
-		}
+template<class ItemType, class NodeAllocator>
+NodeUnit BinaryNodeTree<ItemType, NodeAllocator>::cloneSubtree(const BinaryUnit* oldTreeRootPtr)
+{
+	NodeUnit newRootPtr;
+	if (oldTreeRootPtr == nullptr) return newRootPtr;
 
-		bool result = accessBalancedUncompletedNode(rightPtr, height, current_height - 1, result_ptr);
-		if (!result) result = accessLeftBalancedNode(rightPtr, height, current_height - 1, result_ptr);
-		if (!result) { cout << "Abort C2A6\n"; abort(); }
+	// Each pending entry pairs a source node with the empty link its copy goes into. Nodes are allocated
+	// in preorder, so with NodePoolAllocator a subtree lies in one run of a chunk.
+	SmallStack<pair<const BinaryUnit*, NodeUnit*> > pendingLinks;
+	vector<BinaryUnit*> copiedNodes;
 
-		return true;
-	}
-	else if (nodeRightCount == nodeLeftCount)
-	{
-		bool result;
+	copiedNodes.reserve(oldTreeRootPtr->getNodeCount());
+	pendingLinks.push(make_pair(oldTreeRootPtr, &newRootPtr));
 
-		if (nodeRightCount != halfCount)
-			result = accessBalancedUncompletedNode(leftPtr, height, current_height - 1, result_ptr);
-		else
-			result = accessLeftBalancedNode(leftPtr, height, current_height - 1, result_ptr);
+	while (!pendingLinks.isEmpty())
+	{
+		const BinaryUnit* oldNodePtr = pendingLinks.peek().first;
+		NodeUnit& newLink = *pendingLinks.peek().second;
+		pendingLinks.pop();
 
-		if (!result) { cout << "Abort D38A\n"; abort(); }
+		newLink = cloneNode(oldNodePtr);
+		copiedNodes.push_back(newLink.get());
 
-		return true;
+		if (oldNodePtr->getRightChild() != nullptr)
+			pendingLinks.push(make_pair(oldNodePtr->getRightChild(), &newLink->getRightChildPtrReference()));
+		if (oldNodePtr->getLeftChild() != nullptr)
+			pendingLinks.push(make_pair(oldNodePtr->getLeftChild(), &newLink->getLeftChildPtrReference()));
 	}
 
-	return false;
-} // End accessUncompletedNode()
+	// The links were written directly, so refresh the cached subtree info bottom-up : in reverse preorder,
+	// children come before their parent
+	for (size_t i = copiedNodes.size(); i > 0; i--)
+		copiedNodes[i - 1]->updateSubtreeInfo();
 
+	return newRootPtr;
+} // End cloneSubtree()
 
+template<class ItemType, class NodeAllocator>
+NodeUnit BinaryNodeTree<ItemType, NodeAllocator>::cloneNode(const BinaryUnit* oldNodePtr)
+{
+	NodeUnit newNodePtr = createNode(oldNodePtr->getItem());
+	newNodePtr->setBalanceData(oldNodePtr->getBalanceData());
 
-template<class ItemType>
-bool BinaryNodeTree<ItemType>::add(const ItemType& newData)
+	return newNodePtr;
+}
+
+template<class ItemType, class NodeAllocator>
+int BinaryNodeTree<ItemType, NodeAllocator>::parallelCloneDepth()
 {
-	NodeUnit newNodePtr = std::make_shared<BinaryUnit>(newData);
+	int depth = 0;
 
-	if (rootPtr.get() == nullptr)
-	{
-		rootPtr = newNodePtr;
-	}
-	else
-	{
-		int max_height = getHeightHelper(rootPtr);
+	for (unsigned int threads = std::thread::hardware_concurrency(); threads > 1; threads = (threads + 1) / 2)
+		depth++;
 
-		NodeUnit targetPtr;
-		accessUncompletedNode(rootPtr, targetPtr, max_height, max_height, newData);
+	return depth;
+}
 
-		balancedAdd(targetPtr, newNodePtr);
-	}
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::generalOrderTraverse(void visit(ItemType&)) const
+{
+	if (rootPtr.get() == nullptr) return;
 
-	return true;
-} // end add
+	generalOrder(visit, rootPtr.get());
+} // End generalOrderTraverse()
 
-template<class ItemType>
-NodeUnit BinaryNodeTree<ItemType>::balancedAdd(NodeUnit subTreePtr, NodeUnit newNodePtr)
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::linearOrderTraverse(void visit(ItemType&)) const
 {
-	if (subTreePtr.get() == nullptr)
-	{
-		cout << "BinaryNodeTree::balancedAdd()\n+ Fatal error : The subTreePtr argument cannot be null\n";
-		system("pause");
-		terminate();
-	}
+	if (rootPtr.get() == nullptr) return;
 
-	NodeUnit leftPtr = subTreePtr->getLeftChildPtr();
-	NodeUnit rightPtr = subTreePtr->getRightChildPtr();
+	linearOrder(visit, rootPtr.get());
+} // End linearOrderTraverse()
 
-	if (leftPtr.get() == nullptr)
-	{
-		subTreePtr->setLeftChildPtr(newNodePtr);
-	}
-	else if (rightPtr.get() == nullptr)
-	{
-		subTreePtr->setRightChildPtr(newNodePtr);
-	}
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::preorderTraverse(void visit(ItemType&)) const
+{
+	preorder(visit, rootPtr.get());
+}
 
-	return subTreePtr;
-} // End balancedAdd()
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::postorderTraverse(void visit(ItemType&)) const
+{
+	postorder(visit, rootPtr.get());
+}
 
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::inorderTraverse(void visit(ItemType&)) const
+{
+	inorder(visit, rootPtr.get());
+}
 
-template<class ItemType>
-int BinaryNodeTree<ItemType>::getHeightHelper(NodeUnit subTreePtr)
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::visitItem(Visitor& visit, const ItemType& item, std::true_type)
 {
-	if (subTreePtr == nullptr)
-		return 0;
-	else
-		return 1 + max(getHeightHelper(subTreePtr->getLeftChildPtr()), getHeightHelper(subTreePtr->getRightChildPtr()));
+	visit(item);
+	return true;
+}
 
-} // end getHeightHelper
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::visitItem(Visitor& visit, const ItemType& item, std::false_type)
+{
+	return visit(item) ? true : false;
+}
 
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::visitItem(Visitor& visit, const ItemType& item)
+{
+	return visitItem(visit, item, typename std::is_void<decltype(visit(item))>::type());
+}
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::postorder(void visit(ItemType&), NodeUnit treePtr)
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::preorderVisit(Visitor& visit, const BinaryUnit* treePtr)
 {
-	if (treePtr != nullptr)
-	{
-		postorder(visit, treePtr->getLeftChildPtr());
-		postorder(visit, treePtr->getRightChildPtr());
-		ItemType theItem = treePtr->getItem();
-		visit(theItem);
-	} // End If-statement
-} // End postorder()
+	if (treePtr == nullptr) return true;
 
+	return visitItem(visit, treePtr->getItem()) &&
+		preorderVisit(visit, treePtr->getLeftChild()) &&
+		preorderVisit(visit, treePtr->getRightChild());
+} // End preorderVisit()
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::preorder(void visit(ItemType&), NodeUnit treePtr)
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::inorderVisit(Visitor& visit, const BinaryUnit* treePtr)
 {
-	if (treePtr != nullptr)
-	{
-		ItemType theItem = treePtr->getItem();
-		visit(theItem);
-		preorder(visit, treePtr->getLeftChildPtr());
-		preorder(visit, treePtr->getRightChildPtr());
-	} // End If-statement
-} // End preorder()
+	if (treePtr == nullptr) return true;
 
+	return inorderVisit(visit, treePtr->getLeftChild()) &&
+		visitItem(visit, treePtr->getItem()) &&
+		inorderVisit(visit, treePtr->getRightChild());
+} // End inorderVisit()
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::inorder(void visit(ItemType&), NodeUnit treePtr)
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::postorderVisit(Visitor& visit, const BinaryUnit* treePtr)
 {
-	if (treePtr != nullptr)
-	{
-		inorder(visit, treePtr->getLeftChildPtr());
-		ItemType theItem = treePtr->getItem();
-		visit(theItem);
-		inorder(visit, treePtr->getRightChildPtr());
-	} // End If-statement
-} // End inorder()
+	if (treePtr == nullptr) return true;
+
+	return postorderVisit(visit, treePtr->getLeftChild()) &&
+		postorderVisit(visit, treePtr->getRightChild()) &&
+		visitItem(visit, treePtr->getItem());
+} // End postorderVisit()
 
-template<class ItemType>
-NodeUnit BinaryNodeTree<ItemType>::removeValue(NodeUnit &subTreePtr, const ItemType target, bool& isSuccessful)
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::preorderIterative(Visitor& visit, const BinaryUnit* treePtr)
 {
-	int i;
-	if (subTreePtr.get() == nullptr)
+	SmallStack<const BinaryUnit*> pendingNodes;
+	if (treePtr != nullptr) pendingNodes.push(treePtr);
+
+	while (!pendingNodes.isEmpty())
 	{
-		isSuccessful = false;
-		return subTreePtr;
+		const BinaryUnit* nodePtr = pendingNodes.peek();
+		pendingNodes.pop();
+
+		if (!visitItem(visit, nodePtr->getItem())) return false;
+
+		// Right first, so that the left subtree comes out first
+		if (nodePtr->getRightChild() != nullptr) pendingNodes.push(nodePtr->getRightChild());
+		if (nodePtr->getLeftChild() != nullptr) pendingNodes.push(nodePtr->getLeftChild());
 	}
 
-	vector<ItemType> itemCollection;
-	getNodeCollection(subTreePtr, itemCollection);
+	return true;
+} // End preorderIterative()
 
-	for (i = 0; i < (int)itemCollection.size(); i++)
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::inorderIterative(Visitor& visit, const BinaryUnit* treePtr)
+{
+	SmallStack<const BinaryUnit*> pendingNodes;
+
+	while (treePtr != nullptr || !pendingNodes.isEmpty())
 	{
-		if (itemCollection[i] == target)
+		while (treePtr != nullptr)
 		{
-			isSuccessful = true;
-			itemCollection.erase(itemCollection.begin() + i);
-			break;
+			pendingNodes.push(treePtr);
+			treePtr = treePtr->getLeftChild();
 		}
+
+		treePtr = pendingNodes.peek();
+		pendingNodes.pop();
+
+		if (!visitItem(visit, treePtr->getItem())) return false;
+		treePtr = treePtr->getRightChild();
 	}
 
-	if (i == itemCollection.size()) isSuccessful = false;
+	return true;
+} // End inorderIterative()
 
-	NodeUnit newNodePtr;
-	NodeUnit targetPtr;
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::postorderIterative(Visitor& visit, const BinaryUnit* treePtr)
+{
+	SmallStack<const BinaryUnit*> pendingNodes;
+	const BinaryUnit* lastVisitedPtr = nullptr;
 
-	if (isSuccessful)
+	while (treePtr != nullptr || !pendingNodes.isEmpty())
 	{
-		subTreePtr = nullptr;
-		for (i = 0; i < (int)itemCollection.size(); i++)
+		if (treePtr != nullptr)
 		{
-			newNodePtr = std::make_shared<BinaryUnit >(itemCollection[i]);
+			pendingNodes.push(treePtr);
+			treePtr = treePtr->getLeftChild();
+			continue;
+		}
 
-			if (subTreePtr.get() == nullptr)
-			{
-				subTreePtr = newNodePtr;
-			}
-			else
-			{
-				int max_height = getHeightHelper(subTreePtr);
+		const BinaryUnit* nodePtr = pendingNodes.peek();
+		const BinaryUnit* rightPtr = nodePtr->getRightChild();
 
-				NodeUnit targetPtr;
-				accessUncompletedNode(subTreePtr, targetPtr, max_height, max_height, itemCollection[i]);
+		// A node is visited once its right subtree is done (or absent)
+		if (rightPtr != nullptr && rightPtr != lastVisitedPtr)
+		{
+			treePtr = rightPtr;
+		}
+		else
+		{
+			if (!visitItem(visit, nodePtr->getItem())) return false;
 
-				balancedAdd(targetPtr, newNodePtr);
-			}
+			lastVisitedPtr = nodePtr;
+			pendingNodes.pop();
 		}
 	}
 
-	return subTreePtr;
-}
+	return true;
+} // End postorderIterative()
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::destroyTree(NodeUnit &subTreePtr)
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::visitThreaded(Visitor& visit, const ItemType& item, std::exception_ptr& visitError)
 {
-	subTreePtr = nullptr;
+	try
+	{
+		return visitItem(visit, item);
+	}
+	catch (...)
+	{
+		visitError = std::current_exception();
+		return false;
+	}
 }
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::clear()
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::preorderMorris(Visitor& visit, BinaryUnit* treePtr)
 {
-	destroyTree(rootPtr);
-}
+	bool isVisiting = true;
+	std::exception_ptr visitError;
 
-template<class ItemType>
-NodeUnit BinaryNodeTree<ItemType>::copyTree(const NodeUnit oldTreeRootPtr)
-{
-	return copyTreeHelper(rootPtr, oldTreeRootPtr);
-}
+	while (treePtr != nullptr)
+	{
+		BinaryUnit* leftPtr = treePtr->getLeftChild();
 
-template<class ItemType>
-NodeUnit BinaryNodeTree<ItemType>::copyTreeHelper(NodeUnit &root_ptr, const NodeUnit oldTreeRootPtr)
-{
-	int i;
-	destroyTree(root_ptr);
+		if (leftPtr == nullptr)
+		{
+			if (isVisiting) isVisiting = visitThreaded(visit, treePtr->getItem(), visitError);
+			treePtr = treePtr->getRightChild();
+			continue;
+		}
 
-	if (oldTreeRootPtr.get() == nullptr)
-	{
-		return root_ptr;
+		BinaryUnit* predecessorPtr = leftPtr;
+		while (predecessorPtr->getRightChild() != nullptr && predecessorPtr->getRightChild() != treePtr)
+			predecessorPtr = predecessorPtr->getRightChild();
+
+		if (predecessorPtr->getRightChild() == nullptr)
+		{
+			// First arrival : visit, thread the predecessor back here, then go left.
+			// The thread does not own the node (aliasing constructor over an empty pointer), so no count changes
+			// and the cached subtree info is left alone.
+			if (isVisiting) isVisiting = visitThreaded(visit, treePtr->getItem(), visitError);
+			predecessorPtr->getRightChildPtrReference() = NodeUnit(NodeUnit(), treePtr);
+			treePtr = leftPtr;
+		}
+		else
+		{
+			// Back through the thread : the left subtree is done
+			predecessorPtr->getRightChildPtrReference() = nullptr;
+			treePtr = treePtr->getRightChild();
+		}
 	}
 
-	int max_height = getHeightHelper(oldTreeRootPtr);
+	if (visitError) std::rethrow_exception(visitError);
+	return isVisiting;
+} // End preorderMorris()
 
-	vector<ItemType> itemCollection;
-	getNodeCollection(oldTreeRootPtr, itemCollection);
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::inorderMorris(Visitor& visit, BinaryUnit* treePtr)
+{
+	bool isVisiting = true;
+	std::exception_ptr visitError;
 
-	NodeUnit newNodePtr;
-	NodeUnit targetPtr;
-	for (i = 0; i < (int)itemCollection.size(); i++)
+	while (treePtr != nullptr)
 	{
-		newNodePtr = std::make_shared<BinaryUnit >(itemCollection[i]);
+		BinaryUnit* leftPtr = treePtr->getLeftChild();
+
+		if (leftPtr == nullptr)
+		{
+			if (isVisiting) isVisiting = visitThreaded(visit, treePtr->getItem(), visitError);
+			treePtr = treePtr->getRightChild();
+			continue;
+		}
+
+		BinaryUnit* predecessorPtr = leftPtr;
+		while (predecessorPtr->getRightChild() != nullptr && predecessorPtr->getRightChild() != treePtr)
+			predecessorPtr = predecessorPtr->getRightChild();
 
-		if (root_ptr.get() == nullptr)
+		if (predecessorPtr->getRightChild() == nullptr)
 		{
-			root_ptr = newNodePtr;
+			// First arrival : thread the predecessor back here (without owning, see preorderMorris), then go left
+			predecessorPtr->getRightChildPtrReference() = NodeUnit(NodeUnit(), treePtr);
+			treePtr = leftPtr;
 		}
 		else
 		{
-			int max_height = getHeightHelper(root_ptr);
+			// Back through the thread : the left subtree is done, so this node comes next
+			if (isVisiting) isVisiting = visitThreaded(visit, treePtr->getItem(), visitError);
+			predecessorPtr->getRightChildPtrReference() = nullptr;
+			treePtr = treePtr->getRightChild();
+		}
+	}
 
-			NodeUnit targetPtr;
-			accessUncompletedNode(root_ptr, targetPtr, max_height, max_height, itemCollection[i]);
+	if (visitError) std::rethrow_exception(visitError);
+	return isVisiting;
+} // End inorderMorris()
 
-			balancedAdd(targetPtr, newNodePtr);
-		}
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::visitQueued(Visitor& visit, RingQueue<const BinaryUnit*>& queue)
+{
+	const BinaryUnit* nodePtr = queue.peekFront();
+	queue.dequeue();
+
+	if (nodePtr->getLeftChild() != nullptr) queue.enqueue(nodePtr->getLeftChild());
+	if (nodePtr->getRightChild() != nullptr) queue.enqueue(nodePtr->getRightChild());
+
+	return visitItem(visit, nodePtr->getItem());
+}
+
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::generalOrderVisit(Visitor& visit, const BinaryUnit* treePtr,
+	RingQueue<const BinaryUnit*>& leftQueue, RingQueue<const BinaryUnit*>& rightQueue)
+{
+	leftQueue.clear();
+	rightQueue.clear();
+
+	if (treePtr == nullptr) return true;
+	if (!visitItem(visit, treePtr->getItem())) return false;
+
+	// Insertion order alternates between the two subtrees, each of which is filled in level order :
+	// one breadth-first walk per subtree, taking a node from each in turn
+	if (treePtr->getLeftChild() != nullptr) leftQueue.enqueue(treePtr->getLeftChild());
+	if (treePtr->getRightChild() != nullptr) rightQueue.enqueue(treePtr->getRightChild());
+
+	while (!leftQueue.isEmpty() || !rightQueue.isEmpty())
+	{
+		if (!leftQueue.isEmpty() && !visitQueued(visit, leftQueue)) return false;
+		if (!rightQueue.isEmpty() && !visitQueued(visit, rightQueue)) return false;
 	}
 
-	return root_ptr;
+	return true;
+} // End generalOrderVisit()
+
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::linearOrderVisit(Visitor& visit, const BinaryUnit* treePtr, RingQueue<const BinaryUnit*>& queue)
+{
+	queue.clear();
+	if (treePtr != nullptr) queue.enqueue(treePtr);
+
+	// Breadth-first : every level from left to right
+	while (!queue.isEmpty())
+	{
+		if (!visitQueued(visit, queue)) return false;
+	}
+
+	return true;
+} // End linearOrderVisit()
+
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::preorderTraverse(Visitor visit, TraversalMode mode) const
+{
+	switch (mode)
+	{
+	case TraversalMode::Recursive:
+		return preorderVisit(visit, rootPtr.get());
+	case TraversalMode::Morris:
+		return preorderMorris(visit, rootPtr.get());
+	default:
+		return preorderIterative(visit, rootPtr.get());
+	}
 }
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::generalOrderTraverse(void visit(ItemType&)) const
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::inorderTraverse(Visitor visit, TraversalMode mode) const
 {
-	if (rootPtr.get() == nullptr) return;
+	switch (mode)
+	{
+	case TraversalMode::Recursive:
+		return inorderVisit(visit, rootPtr.get());
+	case TraversalMode::Morris:
+		return inorderMorris(visit, rootPtr.get());
+	default:
+		return inorderIterative(visit, rootPtr.get());
+	}
+}
 
-	int max_height = getHeightHelper(rootPtr);
-	generalOrder(visit, rootPtr, max_height, 1);
-} // End generalOrderTraverse()
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::postorderTraverse(Visitor visit, TraversalMode mode) const
+{
+	if (mode == TraversalMode::Recursive)
+		return postorderVisit(visit, rootPtr.get());
+	else
+		return postorderIterative(visit, rootPtr.get());
+}
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::linearOrderTraverse(void visit(ItemType&)) const
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::generalOrderTraverse(Visitor visit) const
 {
-	if (rootPtr.get() == nullptr) return;
+	RingQueue<const BinaryUnit*> leftQueue, rightQueue;
+	return generalOrderVisit(visit, rootPtr.get(), leftQueue, rightQueue);
+} // End generalOrderTraverse()
 
-	int max_height = getHeightHelper(rootPtr);
-	linearOrder(visit, rootPtr, max_height, 1);
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+bool BinaryNodeTree<ItemType, NodeAllocator>::linearOrderTraverse(Visitor visit) const
+{
+	RingQueue<const BinaryUnit*> queue;
+	return linearOrderVisit(visit, rootPtr.get(), queue);
 } // End linearOrderTraverse()
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::preorderTraverse(void visit(ItemType&)) const
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+void BinaryNodeTree<ItemType, NodeAllocator>::parallelForEach(Visitor visit, int grainSize, WorkStealingPool& pool) const
 {
-	preorder(visit, rootPtr);
+	parallelVisit(visit, rootPtr.get(), max(grainSize, 1), pool);
 }
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::postorderTraverse(void visit(ItemType&)) const
+template<class ItemType, class NodeAllocator>
+template<class Result, class Accumulate, class Combine>
+Result BinaryNodeTree<ItemType, NodeAllocator>::parallelReduce(const Result& identity, Accumulate accumulate, Combine combine,
+	int grainSize, WorkStealingPool& pool) const
 {
-	postorder(visit, rootPtr);
+	return parallelReduceHelper(rootPtr.get(), identity, accumulate, combine, max(grainSize, 1), pool);
 }
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::inorderTraverse(void visit(ItemType&)) const
+template<class ItemType, class NodeAllocator>
+bool BinaryNodeTree<ItemType, NodeAllocator>::isWorthSplitting(const BinaryUnit* treePtr, int grainSize)
 {
-	inorder(visit, rootPtr);
+	if (treePtr == nullptr || treePtr->getNodeCount() <= grainSize) return false;
+
+	int balancedHeight = 1;
+	for (int count = treePtr->getNodeCount(); count > 1; count /= 2)
+		balancedHeight++;
+
+	return treePtr->getHeight() <= 3 * balancedHeight;
 }
 
-template<class ItemType>
-bool BinaryNodeTree<ItemType>::isEmpty() const
+template<class ItemType, class NodeAllocator>
+template<class Visitor>
+void BinaryNodeTree<ItemType, NodeAllocator>::parallelVisit(Visitor& visit, const BinaryUnit* treePtr, int grainSize,
+	WorkStealingPool& pool)
+{
+	WorkStealingPool::TaskGroup group(pool);
+
+	while (isWorthSplitting(treePtr, grainSize))
+	{
+		const BinaryUnit* leftPtr = treePtr->getLeftChild();
+		group.run([&visit, leftPtr, grainSize, &pool]() { parallelVisit(visit, leftPtr, grainSize, pool); });
+
+		visit(treePtr->getItem());
+		treePtr = treePtr->getRightChild();
+	}
+
+	auto visitEntry = [&visit](const ItemType& item) { visit(item); };
+	preorderIterative(visitEntry, treePtr);
+
+	group.wait();
+} // End parallelVisit()
+
+template<class ItemType, class NodeAllocator>
+template<class Result, class Accumulate, class Combine>
+Result BinaryNodeTree<ItemType, NodeAllocator>::parallelReduceHelper(const BinaryUnit* treePtr, const Result& identity,
+	Accumulate& accumulate, Combine& combine, int grainSize, WorkStealingPool& pool)
+{
+	Result result = identity;
+
+	if (!isWorthSplitting(treePtr, grainSize))
+	{
+		auto addEntry = [&result, &accumulate](const ItemType& item) { accumulate(result, item); };
+		inorderIterative(addEntry, treePtr);
+
+		return result;
+	}
+
+	// result = left subtree, then the root, then the right subtree
+	WorkStealingPool::TaskGroup group(pool);
+	group.run([&]()
+	{
+		result = parallelReduceHelper(treePtr->getLeftChild(), identity, accumulate, combine, grainSize, pool);
+	});
+	Result rightResult = parallelReduceHelper(treePtr->getRightChild(), identity, accumulate, combine, grainSize, pool);
+	group.wait();
+
+	accumulate(result, treePtr->getItem());
+	combine(result, rightResult);
+
+	return result;
+} // End parallelReduceHelper()
+
+template<class ItemType, class NodeAllocator>
+bool BinaryNodeTree<ItemType, NodeAllocator>::isEmpty() const
 {
 	return (rootPtr.get() == nullptr);
 }
 
-template<class ItemType>
-int BinaryNodeTree<ItemType>::getHeight() const
+template<class ItemType, class NodeAllocator>
+int BinaryNodeTree<ItemType, NodeAllocator>::getHeight() const
 {
 	return getHeightHelper(rootPtr);
 }
 
-template<class ItemType>
-int BinaryNodeTree<ItemType>::getNumberOfNodes() const
+template<class ItemType, class NodeAllocator>
+int BinaryNodeTree<ItemType, NodeAllocator>::getNumberOfNodes() const
 {
 	return countNumNode(rootPtr);
 }
 
-template<class ItemType>
-ItemType BinaryNodeTree<ItemType>::getRootData() const throw(PrecondViolatedExcept)
+template<class ItemType, class NodeAllocator>
+ItemType BinaryNodeTree<ItemType, NodeAllocator>::getRootData() const throw(PrecondViolatedExcept)
 {
 	if (rootPtr.get() != nullptr)
 	{
@@ -845,19 +1259,20 @@ ItemType BinaryNodeTree<ItemType>::getRootData() const throw(PrecondViolatedExce
 	throw PrecondViolatedExcept("BinaryNodeTree::getRootData() : The rootPtr is null");
 }
 
-template<class ItemType>
-void BinaryNodeTree<ItemType>::setRootData(const ItemType& newData) throw(PrecondViolatedExcept)
+template<class ItemType, class NodeAllocator>
+void BinaryNodeTree<ItemType, NodeAllocator>::setRootData(const ItemType& newData) throw(PrecondViolatedExcept)
 {
 	if (rootPtr.get() != nullptr)
 	{
 		rootPtr->setItem(newData);
+		return;
 	}
 
 	throw PrecondViolatedExcept("BinaryNodeTree::setRootData() : The rootPtr is null");
 }
 
-template<class ItemType>
-bool BinaryNodeTree<ItemType>::remove(const ItemType& data)
+template<class ItemType, class NodeAllocator>
+bool BinaryNodeTree<ItemType, NodeAllocator>::remove(const ItemType& data)
 {
 	bool isSuccessful;
 	removeValue(rootPtr, data, isSuccessful);
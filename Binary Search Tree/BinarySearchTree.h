@@ -7,42 +7,87 @@
 #include "BinaryNodeTree.h"
 #include "NotFoundException.h"
 #include "PrecondViolatedExcept.h"
-
-template<class ItemType>
-class BinarySearchTree : public BinaryNodeTree<ItemType>
+#include "BalancePolicies.h"
+#include "FrozenSearchTree.h"
+#include "TreeIterator.h"
+#include "ParallelSort.h"
+
+// BalancePolicy : UnbalancedPolicy, AvlPolicy, RedBlackPolicy, TreapPolicy or ScapegoatPolicy (see BalancePolicies.h).
+// NodeAllocator : std::allocator (the default) or NodePoolAllocator (see NodePool.h).
+template<class ItemType, class BalancePolicy = UnbalancedPolicy, class NodeAllocator = std::allocator<BinaryNode<ItemType> > >
+class BinarySearchTree : public BinaryNodeTree<ItemType, NodeAllocator>
 {
 private:
-	NodeUnit rootPtr;
+	BalancePolicy balancePolicy;
 
 protected:
 	//------------------------------------------------------------
 	//    Protected Utility Methods Section:
-	//    Recursive helper methods for the public methods.
+	//    Helper methods for the public methods. The insertion and removal paths walk down in a loop and record
+	//    the links they pass, so a degenerate tree (such as sorted input under UnbalancedPolicy) cannot
+	//    overflow the call stack.
 	//------------------------------------------------------------
-	// Places a given new node at its proper position in this binary search tree.
-	NodeUnit placeNode(NodeUnit subTreePtr, NodeUnit newNode);
+	// Places a given new node at its proper position in the subtree linked from subTreePtr.
+	// Entries are compared with operator<, and equal entries are placed to the right.
+	void placeNode(NodeUnit& subTreePtr, const NodeUnit& newNodePtr);
+
+	// Refreshes the cached subtree info of the node on each recorded link, from the last one pushed (the
+	// deepest) to the first, and lets the balancing policy rotate it. Empties path.
+	void rebalancePath(SmallStack<NodeUnit*>& path);
+
+	// Places a new node and lets the balancing policy restore its invariants.
+	void insertNode(NodeUnit newNodePtr);
 
 	// Removes the given target value from the tree while maintaining a binary search tree.
-	NodeUnit removeValue(NodeUnit &subTreePtr, const ItemType target, bool& isSuccessful) override;
+	NodeUnit removeValue(NodeUnit &subTreePtr, const ItemType& target, bool& isSuccessful) override;
 
 	// Removes a given node from a tree while maintaining a binary search tree.
 	NodeUnit removeNode(NodeUnit nodePtr);
 
-	// Removes the (last) node in the left subtree of the node pointed to by nodePtr.
+	// Removes the leftmost node in the subtree pointed to by subTreePtr.
 	// Sets inorderSuccessor to the value in this node.
-	// Returns a pointer to the (last) node (not the node that was removed)
+	// Returns a pointer to the revised subtree.
 	NodeUnit removeLeftmostNode(NodeUnit &subTreePtr, ItemType& inorderSuccessor);
 
-	// Returns a pointer to the node containing the given value, or nullptr if not found.
-	NodeUnit findNode(NodeUnit treePtr, const ItemType& target) const;
+	// Returns the link holding the node containing the given value, or a null link if not found.
+	// The search walks the links in place, so it copies no shared_ptr on the way down.
+	static const NodeUnit& findNode(const NodeUnit& treePtr, const ItemType& target);
+	NodeUnit findNode(const NodeUnit& treePtr, const ItemType& target, bool& isSuccessful) const override;
+
+	// Appends the entries of the tree rooted at treePtr in sorted order, without recursion.
+	static void collectSorted(const BinaryUnit* treePtr, vector<ItemType>& collection);
+
+	// Returns the number of entries less than key or, if isInclusive, not greater than key.
+	int countBelow(const ItemType& key, bool isInclusive) const;
+
+	// Links sortedItems[first, last) into a perfectly balanced subtree and returns its root, moving the items into the nodes.
+	// The right half gets the extra item, so right subtrees are never smaller than their left siblings.
+	NodeUnit buildBalanced(vector<ItemType>& sortedItems, int first, int last);
+
+	// The same, with the left and right halves of large ranges linked by different tasks of pool.
+	// The nodes are allocated on the calling thread unless the allocator is thread safe.
+	NodeUnit buildBalancedParallel(vector<ItemType>& sortedItems, int first, int last, WorkStealingPool& pool);
 
 public:
+	// Inorder iterators handing out the stored entries (see TreeIterator.h). Entries are read-only, since
+	// changing one in place could break the order.
+	typedef TreeIterator<ItemType> iterator;
+	typedef TreeIterator<ItemType> const_iterator;
+	typedef std::reverse_iterator<iterator> reverse_iterator;
+	typedef std::reverse_iterator<iterator> const_reverse_iterator;
+
 	//------------------------------------------------------------
 	// Constructor and Destructor Section.
 	//------------------------------------------------------------
 	BinarySearchTree();
 	BinarySearchTree(const ItemType& rootItem);
-	BinarySearchTree(const BinarySearchTree<ItemType>& tree);
+	BinarySearchTree(const BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>& tree);
+	BinarySearchTree(BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>&& tree) noexcept;
+
+	// Builds a balanced tree from the entries in [first, last), as assign() does.
+	template<class InputIterator>
+	BinarySearchTree(InputIterator first, InputIterator last);
+
 	virtual ~BinarySearchTree();
 
 	//------------------------------------------------------------
@@ -56,12 +101,45 @@ public:
 	void setRootData(const ItemType& newData);
 
 	bool add(const ItemType& newEntry);
-	bool remove(const ItemType& target);
-	void clear();
+	bool add(ItemType&& newEntry);
+
+	// Adds an entry constructed in place from args.
+	template<class... Args>
+	bool emplace(Args&&... args);
 
+	bool remove(const ItemType& target);
+	void clear(); // O(n), see BinaryNodeTree::clear()
+
+	// Replaces the entries of the tree with those in [first, last), which need not be sorted.
+	// The entries are sorted (unless they already are) and linked into a perfectly balanced tree in O(n),
+	// instead of n separate insertions. Equal entries keep their order in the range.
+	// Pass move iterators to move the entries in instead of copying them.
+	template<class InputIterator>
+	void assign(InputIterator first, InputIterator last);
+
+	// The same for large ranges, with the work spread over the threads of pool : the entries are sorted with
+	// ParallelSorter (see ParallelSort.h) and the halves of the tree are linked by different tasks.
+	// If dropDuplicates, only the first of equal entries in the range is kept.
+	// @pre  ItemType is default constructible, unless the range is already sorted and dropDuplicates is false.
+	template<class InputIterator>
+	void parallelAssign(InputIterator first, InputIterator last, bool dropDuplicates = false,
+		WorkStealingPool& pool = WorkStealingPool::getDefault());
+
+	// getEntry, contains and remove find an entry equivalent to anEntry under operator< (neither is less than
+	// the other) : a partial pattern, such as a soundtrack with blank fields, only matches entries equal to it.
 	ItemType getEntry(const ItemType& anEntry) const throw(NotFoundException);
 	bool contains(const ItemType& anEntry) const;
 
+	// Calls visit on each entry e for which e == pattern, in sorted order, for an operator== that matches more
+	// loosely than the order (see soundtrack::operator==). Every entry is compared, in O(n).
+	// A visitor returning bool ends the scan early by returning false.
+	// @return  False if the visitor stopped the scan, or true if every entry was compared.
+	template<class Visitor>
+	bool forEachMatching(const ItemType& pattern, Visitor visit) const;
+
+	// Returns a read-only snapshot of the current entries, laid out for fast lookups (see FrozenSearchTree.h).
+	FrozenSearchTree<ItemType> freeze() const;
+
 	//------------------------------------------------------------
 	// Public Traversals Section.
 	//------------------------------------------------------------
@@ -71,204 +149,660 @@ public:
 	void generalOrderTraverse(void visit(ItemType&)) const;
 	void linearOrderTraverse(void visit(ItemType&)) const;
 
+	// The traversals taking any callable (see BinaryNodeTree.h).
+	using BinaryNodeTree<ItemType, NodeAllocator>::preorderTraverse;
+	using BinaryNodeTree<ItemType, NodeAllocator>::inorderTraverse;
+	using BinaryNodeTree<ItemType, NodeAllocator>::postorderTraverse;
+	using BinaryNodeTree<ItemType, NodeAllocator>::generalOrderTraverse;
+	using BinaryNodeTree<ItemType, NodeAllocator>::linearOrderTraverse;
+
+	//------------------------------------------------------------
+	// Iterators Section.
+	//------------------------------------------------------------
+	iterator begin() const;
+	iterator end() const;
+	reverse_iterator rbegin() const;
+	reverse_iterator rend() const;
+
+	//------------------------------------------------------------
+	// Range Queries Section.
+	// They walk down one path and skip the subtrees outside the range, so they take O(height),
+	// plus O(k) to hand out k entries. Equal entries are all in the range or all out of it.
+	//------------------------------------------------------------
+	iterator lower_bound(const ItemType& key) const; // The first entry not less than key
+	iterator upper_bound(const ItemType& key) const; // The first entry greater than key
+	pair<iterator, iterator> equal_range(const ItemType& key) const;
+
+	// Calls visit on each entry from low to high, both included, in sorted order.
+	// A visitor returning bool ends the scan early by returning false.
+	// @return  False if the visitor stopped the scan, or true if every entry in the range was visited.
+	template<class Visitor>
+	bool forEachInRange(const ItemType& low, const ItemType& high, Visitor visit) const;
+
+	//------------------------------------------------------------
+	// Order Statistics Section.
+	// Every node caches the size of its subtree, so these walk down one path, in O(height).
+	//------------------------------------------------------------
+	// Returns an iterator at the entry of position k in sorted order (0 for the smallest),
+	// or end() if k is not in [0, getNumberOfNodes()). Pages go on from it with ++.
+	iterator select(int k) const;
+
+	// Returns the number of entries less than anEntry, which is the position lower_bound(anEntry) is at.
+	int rank(const ItemType& anEntry) const;
+
+	// Returns the number of entries from low to high, both included.
+	int countInRange(const ItemType& low, const ItemType& high) const;
+
+	//------------------------------------------------------------
+	// Balancing Statistics Section.
+	//------------------------------------------------------------
+	long long getRotationCount() const; // Rotations performed by the balancing policy
+	long long getRebuildCount() const;  // Subtree rebuilds performed by the balancing policy
+
 	//------------------------------------------------------------
 	// Overloaded Operator Section.
 	//------------------------------------------------------------
-	BinarySearchTree<ItemType>&
-		operator=(const BinarySearchTree<ItemType>& rightHandSide);
+	BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>&
+		operator=(const BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>& rightHandSide);
+	BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>&
+		operator=(BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>&& rightHandSide) noexcept;
 }; // end BinarySearchTree
 
-template<class ItemType>
-BinarySearchTree<ItemType>::BinarySearchTree()
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::BinarySearchTree()
+{
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+template<class InputIterator>
+BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::BinarySearchTree(InputIterator first, InputIterator last)
+{
+	assign(first, last);
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::~BinarySearchTree()
 {
 }
 
-template<class ItemType>
-BinarySearchTree<ItemType>::~BinarySearchTree()
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::BinarySearchTree(const ItemType& rootItem)
 {
+	add(rootItem);
 }
 
-template<class ItemType>
-BinarySearchTree<ItemType>::BinarySearchTree(const ItemType& rootItem) : BinaryNodeTree<ItemType>(rootItem)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::BinarySearchTree(const BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>& tree) :
+	BinaryNodeTree<ItemType, NodeAllocator>(tree),
+	balancePolicy(tree.balancePolicy)
 {
 }
 
-template<class ItemType>
-BinarySearchTree<ItemType>::BinarySearchTree(const BinarySearchTree<ItemType>& tree)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::BinarySearchTree(BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>&& tree) noexcept :
+	BinaryNodeTree<ItemType, NodeAllocator>(std::move(tree)),
+	balancePolicy(std::move(tree.balancePolicy))
 {
-	BinaryNodeTree<ItemType>::copyTree(tree.getRoot());
+	tree.balancePolicy.reset();
 }
 
-template<class ItemType>
-BinarySearchTree<ItemType>& BinarySearchTree<ItemType>::operator = (const BinarySearchTree<ItemType>& rightHandSide)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>& BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::operator = (const BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>& rightHandSide)
 {
 	if (&rightHandSide != this)
 	{
-		BinaryNodeTree<ItemType>::copyTree(rightHandSide.getRoot());
+		clear();
+		this->copyTree(rightHandSide.getRoot());
+		balancePolicy = rightHandSide.balancePolicy;
 	}
 
 	return (*this);
 }
 
-template<class ItemType>
-bool BinarySearchTree<ItemType>::isEmpty() const
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>& BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::operator = (BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>&& rightHandSide) noexcept
 {
-	return BinaryNodeTree<ItemType>::isEmpty();
+	if (&rightHandSide != this)
+	{
+		BinaryNodeTree<ItemType, NodeAllocator>::operator=(std::move(rightHandSide));
+		balancePolicy = std::move(rightHandSide.balancePolicy);
+		rightHandSide.balancePolicy.reset();
+	}
+
+	return (*this);
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+bool BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::isEmpty() const
+{
+	return BinaryNodeTree<ItemType, NodeAllocator>::isEmpty();
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+int BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::getHeight() const
+{
+	return BinaryNodeTree<ItemType, NodeAllocator>::getHeight();
 }
 
-template<class ItemType>
-int BinarySearchTree<ItemType>::getHeight() const
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+int BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::getNumberOfNodes() const
+{
+	return BinaryNodeTree<ItemType, NodeAllocator>::getNumberOfNodes();
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+ItemType BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::getRootData() const throw(PrecondViolatedExcept)
+{
+	return BinaryNodeTree<ItemType, NodeAllocator>::getRootData();
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::setRootData(const ItemType& newData) throw(PrecondViolatedExcept)
+{
+	BinaryNodeTree<ItemType, NodeAllocator>::setRootData(newData);
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+bool BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::add(const ItemType& newData)
+{
+	insertNode(this->createNode(newData));
+	return true;
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+bool BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::add(ItemType&& newData)
+{
+	insertNode(this->createNode(std::move(newData)));
+	return true;
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+template<class... Args>
+bool BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::emplace(Args&&... args)
+{
+	insertNode(this->createNode(std::piecewise_construct, std::forward<Args>(args)...));
+	return true;
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::insertNode(NodeUnit newNodePtr)
+{
+	NodeUnit& rootPtr = this->getRootReference();
+
+	balancePolicy.initNode(*newNodePtr);
+	placeNode(rootPtr, newNodePtr);
+	rootPtr = balancePolicy.afterInsert(rootPtr, newNodePtr);
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+bool BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::remove(const ItemType& data)
+{
+	bool isSuccessful = false;
+	NodeUnit& rootPtr = this->getRootReference();
+
+	removeValue(rootPtr, data, isSuccessful);
+	if (isSuccessful) rootPtr = balancePolicy.afterRemove(rootPtr);
+
+	return isSuccessful;
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::clear()
+{
+	BinaryNodeTree<ItemType, NodeAllocator>::clear();
+	balancePolicy.reset();
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+ItemType BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::getEntry(const ItemType& anEntry) const throw(NotFoundException)
+{
+	const NodeUnit& entryPtr = findNode(this->getRoot(), anEntry);
+
+	if (entryPtr.get() != nullptr) return entryPtr->getItem();
+	throw NotFoundException("BinarySearchTree::getEntry : Entry not found");
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+bool BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::contains(const ItemType& anEntry) const
+{
+	return (findNode(this->getRoot(), anEntry).get() != nullptr);
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+template<class InputIterator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::assign(InputIterator first, InputIterator last)
+{
+	vector<ItemType> sortedItems(first, last);
+
+	if (!std::is_sorted(sortedItems.begin(), sortedItems.end()))
+		std::stable_sort(sortedItems.begin(), sortedItems.end());
+
+	clear();
+
+	NodeUnit& rootPtr = this->getRootReference();
+	rootPtr = buildBalanced(sortedItems, 0, (int)sortedItems.size());
+	rootPtr = balancePolicy.afterBuild(rootPtr);
+} // End assign()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+template<class InputIterator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::parallelAssign(InputIterator first, InputIterator last,
+	bool dropDuplicates, WorkStealingPool& pool)
+{
+	vector<ItemType> sortedItems(first, last);
+
+	if (!std::is_sorted(sortedItems.begin(), sortedItems.end()))
+		ParallelSorter<ItemType>::sort(sortedItems, dropDuplicates, pool);
+	else if (dropDuplicates)
+		ParallelSorter<ItemType>::removeDuplicates(sortedItems, pool);
+
+	clear();
+
+	NodeUnit& rootPtr = this->getRootReference();
+	rootPtr = buildBalancedParallel(sortedItems, 0, (int)sortedItems.size(), pool);
+	rootPtr = balancePolicy.afterBuild(rootPtr);
+} // End parallelAssign()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+NodeUnit BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::buildBalanced(vector<ItemType>& sortedItems, int first, int last)
+{
+	if (first >= last) return NodeUnit();
+
+	int middle = first + (last - first - 1) / 2;
+
+	// Nodes are allocated in preorder, so each one sits next to its left child (and in one run of a NodePool chunk)
+	NodeUnit nodePtr = this->createNode(std::move(sortedItems[middle]));
+
+	nodePtr->setLeftChildPtr(buildBalanced(sortedItems, first, middle));
+	nodePtr->setRightChildPtr(buildBalanced(sortedItems, middle + 1, last));
+
+	return nodePtr;
+} // End buildBalanced()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+NodeUnit BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::buildBalancedParallel(vector<ItemType>& sortedItems,
+	int first, int last, WorkStealingPool& pool)
 {
-	return BinaryNodeTree<ItemType>::getHeight();
+	if (!this->canAllocateInParallel || last - first <= this->defaultGrainSize)
+		return buildBalanced(sortedItems, first, last);
+
+	int middle = first + (last - first - 1) / 2;
+	NodeUnit nodePtr = this->createNode(std::move(sortedItems[middle]));
+
+	// The left half is linked by another task while this one links the right half
+	NodeUnit leftPtr;
+	WorkStealingPool::TaskGroup group(pool);
+	group.run([this, &sortedItems, first, middle, &pool, &leftPtr]()
+	{
+		leftPtr = buildBalancedParallel(sortedItems, first, middle, pool);
+	});
+	NodeUnit rightPtr = buildBalancedParallel(sortedItems, middle + 1, last, pool);
+	group.wait();
+
+	nodePtr->getLeftChildPtrReference() = std::move(leftPtr);
+	nodePtr->setRightChildPtr(std::move(rightPtr)); // Refreshes the subtree info with both children in place
+
+	return nodePtr;
+} // End buildBalancedParallel()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+FrozenSearchTree<ItemType> BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::freeze() const
+{
+	vector<ItemType> sortedItems;
+	sortedItems.reserve(this->getNumberOfNodes());
+	collectSorted(this->getRoot().get(), sortedItems);
+
+	return FrozenSearchTree<ItemType>(sortedItems);
 }
 
-template<class ItemType>
-int BinarySearchTree<ItemType>::getNumberOfNodes() const
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::preorderTraverse(void visit(ItemType&)) const
 {
-	return BinaryNodeTree<ItemType>::getNumberOfNodes();
+	BinaryNodeTree<ItemType, NodeAllocator>::preorderTraverse(visit);
 }
 
-template<class ItemType>
-ItemType BinarySearchTree<ItemType>::getRootData() const throw(PrecondViolatedExcept)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::inorderTraverse(void visit(ItemType&)) const
 {
-	return BinaryNodeTree<ItemType>::getRootData();
+	BinaryNodeTree<ItemType, NodeAllocator>::inorderTraverse(visit);
 }
 
-template<class ItemType>
-void BinarySearchTree<ItemType>::setRootData(const ItemType& newData) throw(PrecondViolatedExcept)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::postorderTraverse(void visit(ItemType&)) const
 {
-	BinaryNodeTree<ItemType>::setRootData(newData);
+	BinaryNodeTree<ItemType, NodeAllocator>::postorderTraverse(visit);
 }
 
-template<class ItemType>
-bool BinarySearchTree<ItemType>::add(const ItemType& newData)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::generalOrderTraverse(void visit(ItemType&)) const
 {
-	return BinaryNodeTree<ItemType>::add(newData);
+	BinaryNodeTree<ItemType, NodeAllocator>::generalOrderTraverse(visit);
 }
 
-template<class ItemType>
-bool BinarySearchTree<ItemType>::remove(const ItemType& data)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::linearOrderTraverse(void visit(ItemType&)) const
 {
-	return BinaryNodeTree<ItemType>::remove(data);
+	BinaryNodeTree<ItemType, NodeAllocator>::linearOrderTraverse(visit);
 }
 
-template<class ItemType>
-void BinarySearchTree<ItemType>::clear()
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+typename BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::iterator BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::begin() const
 {
-	BinaryNodeTree<ItemType>::clear();
+	return iterator(this->getRoot().get(), false);
 }
 
-template<class ItemType>
-ItemType BinarySearchTree<ItemType>::getEntry(const ItemType& anEntry) const throw(NotFoundException)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+typename BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::iterator BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::end() const
 {
-	return BinaryNodeTree<ItemType>::getEntry(anEntry);
+	return iterator(this->getRoot().get(), true);
 }
 
-template<class ItemType>
-bool BinarySearchTree<ItemType>::contains(const ItemType& anEntry) const
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+typename BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::reverse_iterator BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::rbegin() const
 {
-	return BinaryNodeTree<ItemType>::contains(anEntry);
+	return reverse_iterator(end());
 }
 
-template<class ItemType>
-void BinarySearchTree<ItemType>::preorderTraverse(void visit(ItemType&)) const
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+typename BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::reverse_iterator BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::rend() const
 {
-	BinaryNodeTree<ItemType>::preorderTraverse(visit);
+	return reverse_iterator(begin());
 }
 
-template<class ItemType>
-void BinarySearchTree<ItemType>::inorderTraverse(void visit(ItemType&)) const
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+typename BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::iterator BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::lower_bound(const ItemType& key) const
 {
-	BinaryNodeTree<ItemType>::inorderTraverse(visit);
+	return iterator(this->getRoot().get(), key, false);
 }
 
-template<class ItemType>
-void BinarySearchTree<ItemType>::postorderTraverse(void visit(ItemType&)) const
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+typename BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::iterator BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::upper_bound(const ItemType& key) const
 {
-	BinaryNodeTree<ItemType>::postorderTraverse(visit);
+	return iterator(this->getRoot().get(), key, true);
 }
 
-template<class ItemType>
-void BinarySearchTree<ItemType>::generalOrderTraverse(void visit(ItemType&)) const
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+pair<typename BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::iterator, typename BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::iterator>
+BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::equal_range(const ItemType& key) const
 {
-	BinaryNodeTree<ItemType>::generalOrderTraverse(visit);
+	return make_pair(lower_bound(key), upper_bound(key));
 }
 
-template<class ItemType>
-void BinarySearchTree<ItemType>::linearOrderTraverse(void visit(ItemType&)) const
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+template<class Visitor>
+bool BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::forEachMatching(const ItemType& pattern, Visitor visit) const
 {
-	BinaryNodeTree<ItemType>::linearOrderTraverse(visit);
+	for (iterator entryIter = begin(); entryIter != end(); ++entryIter)
+	{
+		if (*entryIter == pattern && !this->visitItem(visit, *entryIter)) return false;
+	}
+
+	return true;
+} // End forEachMatching()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+template<class Visitor>
+bool BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::forEachInRange(const ItemType& low, const ItemType& high, Visitor visit) const
+{
+	SmallStack<const BinaryUnit*> pendingNodes;
+	const BinaryUnit* nodePtr = this->getRoot().get();
+
+	while (nodePtr != nullptr || !pendingNodes.isEmpty())
+	{
+		// Go down the left side, skipping the nodes below low together with their left subtrees
+		while (nodePtr != nullptr)
+		{
+			if (nodePtr->getItem() < low)
+			{
+				nodePtr = nodePtr->getRightChild();
+			}
+			else
+			{
+				pendingNodes.push(nodePtr);
+				nodePtr = nodePtr->getLeftChild();
+			}
+		}
+
+		if (pendingNodes.isEmpty()) break;
+
+		nodePtr = pendingNodes.peek();
+		pendingNodes.pop();
+
+		// Every entry after this one is above high too
+		if (high < nodePtr->getItem()) break;
+
+		if (!this->visitItem(visit, nodePtr->getItem())) return false;
+		nodePtr = nodePtr->getRightChild();
+	}
+
+	return true;
+} // End forEachInRange()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+typename BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::iterator BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::select(int k) const
+{
+	return iterator::atPosition(this->getRoot().get(), k);
 }
 
-template<class ItemType>
-NodeUnit BinarySearchTree<ItemType>::placeNode(NodeUnit subTreePtr, NodeUnit newNodePtr)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+int BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::rank(const ItemType& anEntry) const
 {
-	return BinaryNodeTree<ItemType>::balancedAdd(subTreePtr, newNodePtr);
+	return countBelow(anEntry, false);
 }
 
-template<class ItemType>
-NodeUnit BinarySearchTree<ItemType>::removeValue(NodeUnit &subTreePtr, const ItemType target, bool& isSuccessful)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+int BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::countInRange(const ItemType& low, const ItemType& high) const
 {
-	return BinaryNodeTree<ItemType>::removeValue(subTreePtr, target, isSuccessful);
+	if (high < low) return 0;
+
+	return countBelow(high, true) - countBelow(low, false);
 }
 
-template<class ItemType>
-NodeUnit BinarySearchTree<ItemType>::removeNode(NodeUnit nodePtr)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+int BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::countBelow(const ItemType& key, bool isInclusive) const
 {
-	if (nodePtr.get() == nullptr)
+	int count = 0;
+	const BinaryUnit* nodePtr = this->getRoot().get();
+
+	while (nodePtr != nullptr)
 	{
-		return nodePtr;
+		bool isBelow = isInclusive ? !(key < nodePtr->getItem()) : (nodePtr->getItem() < key);
+
+		if (isBelow)
+		{
+			// The node and its whole left subtree count
+			const BinaryUnit* leftPtr = nodePtr->getLeftChild();
+			count += 1 + ((leftPtr == nullptr) ? 0 : leftPtr->getNodeCount());
+			nodePtr = nodePtr->getRightChild();
+		}
+		else
+		{
+			nodePtr = nodePtr->getLeftChild();
+		}
 	}
 
-	bool isSuccessful;
-	ItemType myItem = nodePtr.getItem();
-	return BinaryNodeTree<ItemType>::removeValue(nodePtr.getRoot(), myItem, isSuccessful);
+	return count;
+} // End countBelow()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+long long BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::getRotationCount() const
+{
+	return balancePolicy.getRotationCount();
 }
 
-template<class ItemType>
-NodeUnit BinarySearchTree<ItemType>::removeLeftmostNode(NodeUnit &subTreePtr, ItemType& inorderSuccessor)
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+long long BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::getRebuildCount() const
 {
-	int i;
-	if (subTreePtr.get() == nullptr)
+	return balancePolicy.getRebuildCount();
+}
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::placeNode(NodeUnit& subTreePtr, const NodeUnit& newNodePtr)
+{
+	SmallStack<NodeUnit*> path;
+	NodeUnit* linkPtr = &subTreePtr;
+
+	while (linkPtr->get() != nullptr)
 	{
-		return subTreePtr;
+		path.push(linkPtr);
+		BinaryUnit* nodePtr = linkPtr->get();
+
+		if (newNodePtr->getItem() < nodePtr->getItem())
+			linkPtr = &nodePtr->getLeftChildPtrReference();
+		else
+			linkPtr = &nodePtr->getRightChildPtrReference();
 	}
 
-	vector<ItemType> itemCollection;
-	getNodeCollection(subTreePtr, itemCollection);
+	*linkPtr = newNodePtr;
+	rebalancePath(path);
+} // End placeNode()
 
-	inorderSuccessor = itemCollection.back();
-	itemCollection.erase(itemCollection.end() - 1);
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::rebalancePath(SmallStack<NodeUnit*>& path)
+{
+	// Each link lives in the node above it, which the rotations below leave in place
+	while (!path.isEmpty())
+	{
+		NodeUnit& link = *path.peek();
+		path.pop();
 
-	NodeUnit newNodePtr;
-	NodeUnit targetPtr;
+		link->updateSubtreeInfo();
+		link = balancePolicy.rebalance(link);
+	}
+} // End rebalancePath()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+NodeUnit BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::removeValue(NodeUnit &subTreePtr, const ItemType& target, bool& isSuccessful)
+{
+	SmallStack<NodeUnit*> path;
+	NodeUnit* linkPtr = &subTreePtr;
 
-	subTreePtr = nullptr;
-	for (i = 0; i < (int)itemCollection.size(); i++)
+	while (linkPtr->get() != nullptr)
 	{
-		newNodePtr = std::make_shared<BinaryUnit >(itemCollection[i]);
+		BinaryUnit* nodePtr = linkPtr->get();
 
-		if (subTreePtr.get() == nullptr)
+		if (target < nodePtr->getItem())
 		{
-			subTreePtr = newNodePtr;
+			path.push(linkPtr);
+			linkPtr = &nodePtr->getLeftChildPtrReference();
+		}
+		else if (nodePtr->getItem() < target)
+		{
+			path.push(linkPtr);
+			linkPtr = &nodePtr->getRightChildPtrReference();
 		}
 		else
 		{
-			int max_height = getHeightHelper(subTreePtr);
+			break;
+		}
+	}
 
-			NodeUnit targetPtr;
-			accessUncompletedNode(subTreePtr, targetPtr, max_height, max_height, itemCollection[i]);
+	isSuccessful = (linkPtr->get() != nullptr);
+	if (!isSuccessful) return subTreePtr;
 
-			balancedAdd(targetPtr, newNodePtr);
-		}
+	// The node that takes the removed one's place is rebalanced too
+	*linkPtr = removeNode(*linkPtr);
+	if (linkPtr->get() != nullptr) path.push(linkPtr);
+
+	rebalancePath(path);
+
+	return subTreePtr;
+} // End removeValue()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+NodeUnit BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::removeNode(NodeUnit nodePtr)
+{
+	if (nodePtr.get() == nullptr || nodePtr->isLeaf())
+	{
+		return nullptr;
+	}
+
+	NodeUnit leftPtr = nodePtr->getLeftChildPtr();
+	NodeUnit rightPtr = nodePtr->getRightChildPtr();
+
+	if (leftPtr.get() == nullptr) return rightPtr;
+	if (rightPtr.get() == nullptr) return leftPtr;
+
+	// Two children : the inorder successor takes the place of the removed item
+	ItemType inorderSuccessor;
+	nodePtr->setRightChildPtr(removeLeftmostNode(rightPtr, inorderSuccessor));
+	nodePtr->setItem(std::move(inorderSuccessor));
+
+	return nodePtr;
+} // End removeNode()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+NodeUnit BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::removeLeftmostNode(NodeUnit &subTreePtr, ItemType& inorderSuccessor)
+{
+	if (subTreePtr.get() == nullptr)
+	{
+		return subTreePtr;
 	}
-}
 
-template<class ItemType>
-NodeUnit BinarySearchTree<ItemType>::findNode(NodeUnit treePtr, const ItemType& target) const
+	SmallStack<NodeUnit*> path;
+	NodeUnit* linkPtr = &subTreePtr;
+
+	while ((*linkPtr)->getLeftChild() != nullptr)
+	{
+		path.push(linkPtr);
+		linkPtr = &(*linkPtr)->getLeftChildPtrReference();
+	}
+
+	inorderSuccessor = std::move((*linkPtr)->getItemReference()); // The node is unlinked right after
+	*linkPtr = removeNode(*linkPtr);
+	rebalancePath(path);
+
+	return subTreePtr;
+} // End removeLeftmostNode()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+const NodeUnit& BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::findNode(const NodeUnit& treePtr, const ItemType& target)
+{
+	const NodeUnit* linkPtr = &treePtr;
+
+	while (linkPtr->get() != nullptr)
+	{
+		const BinaryUnit* nodePtr = linkPtr->get();
+
+		if (target < nodePtr->getItem())
+			linkPtr = &nodePtr->getLeftChildPtr();
+		else if (nodePtr->getItem() < target)
+			linkPtr = &nodePtr->getRightChildPtr();
+		else
+			break;
+	}
+
+	return *linkPtr;
+} // End findNode()
+
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+NodeUnit BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::findNode(const NodeUnit& treePtr, const ItemType& target, bool& isSuccessful) const
 {
-	bool isSuccessful;
-	return BinaryNodeTree<ItemType>::findNode(treePtr, target, isSuccessful);
+	const NodeUnit& resultPtr = findNode(treePtr, target);
+
+	isSuccessful = (resultPtr.get() != nullptr);
+	return resultPtr;
 }
 
+template<class ItemType, class BalancePolicy, class NodeAllocator>
+void BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>::collectSorted(const BinaryUnit* treePtr, vector<ItemType>& collection)
+{
+	vector<const BinaryUnit*> pendingNodes;
+
+	while (treePtr != nullptr || !pendingNodes.empty())
+	{
+		while (treePtr != nullptr)
+		{
+			pendingNodes.push_back(treePtr);
+			treePtr = treePtr->getLeftChild();
+		}
+
+		treePtr = pendingNodes.back();
+		pendingNodes.pop_back();
+
+		collection.push_back(treePtr->getItem());
+		treePtr = treePtr->getRightChild();
+	}
+} // End collectSorted()
+
 #endif
@@ -0,0 +1,310 @@
+#ifndef CONCURRENT_SEARCH_TREE_
+#define CONCURRENT_SEARCH_TREE_
+
+#include "PersistentSearchTree.h"
+#include "PrecondViolatedExcept.h"
+#include "TraversalStack.h"
+#include <atomic>
+#include <mutex>
+#include <deque>
+
+using namespace std;
+
+// Search tree for many reader threads and writers that take turns, read-copy-update style.
+// Writers serialize on a mutex, change a PersistentSearchTree (which copies only the changed path) and publish
+// the new root with one atomic store. Readers never lock : they announce the epoch they start in, load the
+// published root, and walk nodes that no one changes.
+// A replaced version is retired with the epoch it was replaced in, and dropped by a later writer once every
+// reader has announced a later epoch, so no reader can still be walking it. Dropping a version only frees the
+// nodes the newer versions do not share.
+template<class ItemType>
+class ConcurrentSearchTree
+{
+private:
+	// One per reader, padded to its own cache line so that readers do not slow each other down.
+	struct ReaderSlot
+	{
+		std::atomic<unsigned long long> epoch; // 0 when the reader is outside a read
+		std::atomic<bool> isClaimed;
+		char padding[64 - sizeof(std::atomic<unsigned long long>) - sizeof(std::atomic<bool>)];
+
+		ReaderSlot() : epoch(0), isClaimed(false) {}
+	};
+
+	static const int maxReaders = 128;
+
+	ReaderSlot readerSlots[maxReaders];
+	std::atomic<unsigned long long> globalEpoch;
+	std::atomic<const BinaryUnit*> publishedRoot;
+
+	// Writer state, guarded by writerMutex.
+	std::mutex writerMutex;
+	PersistentSearchTree<ItemType> writerTree;
+	SearchTreeSnapshot<ItemType> publishedVersion;
+	deque<pair<unsigned long long, SearchTreeSnapshot<ItemType> > > retiredVersions; // Oldest first
+
+	// Publishes writerTree's root, retires the version it replaces and drops the versions no reader can hold.
+	void publish();
+	void reclaim();
+
+public:
+	// A reader thread's access to the tree. Each reader holds one of maxReaders slots until it is destroyed,
+	// and must only be used by one thread at a time.
+	class Reader
+	{
+	private:
+		ConcurrentSearchTree* treePtr;
+		ReaderSlot* slotPtr;
+
+		// Announces the reader for the duration of one read.
+		class ReadSection
+		{
+		private:
+			ReaderSlot* slotPtr;
+
+		public:
+			const BinaryUnit* rootPtr;
+
+			ReadSection(const Reader& reader) : slotPtr(reader.slotPtr)
+			{
+				// The announcement must be visible before the root is read (both sequentially consistent)
+				slotPtr->epoch.store(reader.treePtr->globalEpoch.load());
+				rootPtr = reader.treePtr->publishedRoot.load();
+			}
+
+			~ReadSection() { slotPtr->epoch.store(0, std::memory_order_release); }
+		};
+
+	public:
+		Reader(ConcurrentSearchTree& tree) throw(PrecondViolatedExcept);
+		Reader(Reader&& reader);
+		~Reader();
+
+		Reader(const Reader&) = delete;
+		Reader& operator=(const Reader&) = delete;
+
+		bool isEmpty() const;
+		int getNumberOfNodes() const;
+
+		ItemType getEntry(const ItemType& anEntry) const throw(NotFoundException);
+		bool contains(const ItemType& anEntry) const;
+
+		// Calls visit on each entry in sorted order, as of the version published when the call started.
+		template<class Visitor>
+		void inorderTraverse(Visitor visit) const;
+	}; // end Reader
+
+	//------------------------------------------------------------
+	// Constructor and Destructor Section.
+	//------------------------------------------------------------
+	ConcurrentSearchTree();
+
+	// @pre  Every Reader of the tree has been destroyed.
+	~ConcurrentSearchTree() {}
+
+	ConcurrentSearchTree(const ConcurrentSearchTree&) = delete;
+	ConcurrentSearchTree& operator=(const ConcurrentSearchTree&) = delete;
+
+	//------------------------------------------------------------
+	// Writer Section. Writers wait for one another, never for readers.
+	//------------------------------------------------------------
+	bool add(const ItemType& newEntry);
+	bool remove(const ItemType& target);
+	void clear();
+
+	// Applies several changes to the tree and publishes them together : readers see all of them or none.
+	// edit is called with the PersistentSearchTree<ItemType>& to change.
+	template<class Edit>
+	void update(Edit edit);
+
+	// Returns the published version as a snapshot that stays valid with no reader slot (see PersistentSearchTree.h).
+	SearchTreeSnapshot<ItemType> snapshot();
+}; // end ConcurrentSearchTree
+
+   // -------------------Definitons----------------------------
+template<class ItemType>
+ConcurrentSearchTree<ItemType>::ConcurrentSearchTree() : globalEpoch(1), publishedRoot(nullptr) {}
+
+template<class ItemType>
+template<class Edit>
+void ConcurrentSearchTree<ItemType>::update(Edit edit)
+{
+	std::lock_guard<std::mutex> lock(writerMutex);
+
+	edit(writerTree);
+	publish();
+}
+
+template<class ItemType>
+bool ConcurrentSearchTree<ItemType>::add(const ItemType& newEntry)
+{
+	bool isSuccessful = false;
+	update([&](PersistentSearchTree<ItemType>& tree) { isSuccessful = tree.add(newEntry); });
+
+	return isSuccessful;
+}
+
+template<class ItemType>
+bool ConcurrentSearchTree<ItemType>::remove(const ItemType& target)
+{
+	bool isSuccessful = false;
+	update([&](PersistentSearchTree<ItemType>& tree) { isSuccessful = tree.remove(target); });
+
+	return isSuccessful;
+}
+
+template<class ItemType>
+void ConcurrentSearchTree<ItemType>::clear()
+{
+	update([](PersistentSearchTree<ItemType>& tree) { tree.clear(); });
+}
+
+template<class ItemType>
+SearchTreeSnapshot<ItemType> ConcurrentSearchTree<ItemType>::snapshot()
+{
+	std::lock_guard<std::mutex> lock(writerMutex);
+
+	return publishedVersion;
+}
+
+template<class ItemType>
+void ConcurrentSearchTree<ItemType>::publish()
+{
+	SearchTreeSnapshot<ItemType> newVersion = writerTree.snapshot();
+
+	// A failed remove leaves the same root : nothing to publish
+	if (newVersion.rootPtr == publishedVersion.rootPtr) return;
+
+	publishedRoot.store(newVersion.rootPtr.get());
+
+	// Readers that announce a later epoch load the new root, so they cannot reach the replaced version
+	unsigned long long replacedEpoch = globalEpoch.fetch_add(1);
+	retiredVersions.push_back(make_pair(replacedEpoch, std::move(publishedVersion)));
+	publishedVersion = std::move(newVersion);
+
+	reclaim();
+} // End publish()
+
+template<class ItemType>
+void ConcurrentSearchTree<ItemType>::reclaim()
+{
+	unsigned long long oldestEpoch = globalEpoch.load();
+
+	for (int i = 0; i < maxReaders; i++)
+	{
+		unsigned long long readerEpoch = readerSlots[i].epoch.load();
+		if (readerEpoch != 0 && readerEpoch < oldestEpoch) oldestEpoch = readerEpoch;
+	}
+
+	while (!retiredVersions.empty() && retiredVersions.front().first < oldestEpoch)
+		retiredVersions.pop_front();
+}
+
+template<class ItemType>
+ConcurrentSearchTree<ItemType>::Reader::Reader(ConcurrentSearchTree<ItemType>& tree) throw(PrecondViolatedExcept) :
+	treePtr(&tree),
+	slotPtr(nullptr)
+{
+	for (int i = 0; i < maxReaders; i++)
+	{
+		bool isClaimed = false;
+
+		if (tree.readerSlots[i].isClaimed.compare_exchange_strong(isClaimed, true))
+		{
+			slotPtr = &tree.readerSlots[i];
+			return;
+		}
+	}
+
+	throw PrecondViolatedExcept("ConcurrentSearchTree::Reader : Every reader slot is taken");
+}
+
+template<class ItemType>
+ConcurrentSearchTree<ItemType>::Reader::Reader(Reader&& reader) : treePtr(reader.treePtr), slotPtr(reader.slotPtr)
+{
+	reader.slotPtr = nullptr;
+}
+
+template<class ItemType>
+ConcurrentSearchTree<ItemType>::Reader::~Reader()
+{
+	if (slotPtr != nullptr) slotPtr->isClaimed.store(false);
+}
+
+template<class ItemType>
+bool ConcurrentSearchTree<ItemType>::Reader::isEmpty() const
+{
+	ReadSection section(*this);
+	return (section.rootPtr == nullptr);
+}
+
+template<class ItemType>
+int ConcurrentSearchTree<ItemType>::Reader::getNumberOfNodes() const
+{
+	ReadSection section(*this);
+	return (section.rootPtr == nullptr) ? 0 : section.rootPtr->getNodeCount();
+}
+
+template<class ItemType>
+ItemType ConcurrentSearchTree<ItemType>::Reader::getEntry(const ItemType& anEntry) const throw(NotFoundException)
+{
+	ReadSection section(*this);
+	const BinaryUnit* nodePtr = section.rootPtr;
+
+	while (nodePtr != nullptr)
+	{
+		if (anEntry < nodePtr->getItem())
+			nodePtr = nodePtr->getLeftChild();
+		else if (nodePtr->getItem() < anEntry)
+			nodePtr = nodePtr->getRightChild();
+		else
+			return nodePtr->getItem();
+	}
+
+	throw NotFoundException("ConcurrentSearchTree::getEntry : Entry not found");
+}
+
+template<class ItemType>
+bool ConcurrentSearchTree<ItemType>::Reader::contains(const ItemType& anEntry) const
+{
+	ReadSection section(*this);
+	const BinaryUnit* nodePtr = section.rootPtr;
+
+	while (nodePtr != nullptr)
+	{
+		if (anEntry < nodePtr->getItem())
+			nodePtr = nodePtr->getLeftChild();
+		else if (nodePtr->getItem() < anEntry)
+			nodePtr = nodePtr->getRightChild();
+		else
+			return true;
+	}
+
+	return false;
+}
+
+template<class ItemType>
+template<class Visitor>
+void ConcurrentSearchTree<ItemType>::Reader::inorderTraverse(Visitor visit) const
+{
+	ReadSection section(*this);
+	const BinaryUnit* nodePtr = section.rootPtr;
+	SmallStack<const BinaryUnit*> pendingNodes;
+
+	while (nodePtr != nullptr || !pendingNodes.isEmpty())
+	{
+		while (nodePtr != nullptr)
+		{
+			pendingNodes.push(nodePtr);
+			nodePtr = nodePtr->getLeftChild();
+		}
+
+		nodePtr = pendingNodes.peek();
+		pendingNodes.pop();
+
+		visit(nodePtr->getItem());
+		nodePtr = nodePtr->getRightChild();
+	}
+} // End inorderTraverse()
+
+#endif
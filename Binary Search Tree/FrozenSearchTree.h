@@ -0,0 +1,179 @@
+#ifndef FROZEN_SEARCH_TREE_
+#define FROZEN_SEARCH_TREE_
+
+#include "General.h"
+#include "NotFoundException.h"
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#define FROZEN_PREFETCH(address) _mm_prefetch((const char*)(address), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#define FROZEN_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define FROZEN_PREFETCH(address)
+#endif
+
+using namespace std;
+
+// Read-only snapshot of a binary search tree, built by BinarySearchTree::freeze().
+// The entries are stored in Eytzinger order (the level order of a complete tree) in one contiguous buffer :
+// entry k has its children at 2k and 2k + 1, so a lookup follows array indices instead of node pointers.
+// The snapshot does not change when the tree it came from does.
+template<class ItemType>
+class FrozenSearchTree
+{
+private:
+	vector<ItemType> layout; // 1-based : layout[0] is unused
+	int nodeCount;
+
+	// Entries per 64-byte cache line, at least one. Entries k * prefetchStride onward are the descendants of k
+	// that the search reaches log2(prefetchStride) levels further down. The buffer is not aligned to a line,
+	// so they may straddle two lines : prefetching the first one loads one of the two.
+	static const int prefetchStride = (sizeof(ItemType) < 64) ? (int)(64 / sizeof(ItemType)) : 1;
+
+	// Places sortedItems[index...] into the subtree rooted at position k in inorder, and returns the next index.
+	int fillLayout(const vector<ItemType>& sortedItems, int index, int k);
+
+	// Returns the Eytzinger position of the first entry not less than target, or 0 if there is none.
+	int lowerBoundPosition(const ItemType& target) const;
+
+public:
+	//------------------------------------------------------------
+	// Constructor Section.
+	//------------------------------------------------------------
+	FrozenSearchTree();
+
+	// @pre  sortedItems is sorted with operator<.
+	FrozenSearchTree(const vector<ItemType>& sortedItems);
+
+	//------------------------------------------------------------
+	// Public Methods Section.
+	//------------------------------------------------------------
+	bool isEmpty() const;
+	int getNumberOfNodes() const;
+
+	// Returns the first entry not less than target, or nullptr if every entry is less than target.
+	// The pointer stays valid as long as the snapshot does.
+	const ItemType* lowerBound(const ItemType& target) const;
+
+	ItemType getEntry(const ItemType& anEntry) const throw(NotFoundException);
+	bool contains(const ItemType& anEntry) const;
+
+	// Visits the entries in sorted order.
+	void inorderTraverse(void visit(ItemType&)) const;
+}; // end FrozenSearchTree
+
+   // -------------------Definitons----------------------------
+template<class ItemType>
+FrozenSearchTree<ItemType>::FrozenSearchTree() : nodeCount(0) {}
+
+template<class ItemType>
+FrozenSearchTree<ItemType>::FrozenSearchTree(const vector<ItemType>& sortedItems) : nodeCount((int)sortedItems.size())
+{
+	if (nodeCount == 0) return;
+
+	layout.assign(nodeCount + 1, sortedItems.front());
+	fillLayout(sortedItems, 0, 1);
+}
+
+template<class ItemType>
+int FrozenSearchTree<ItemType>::fillLayout(const vector<ItemType>& sortedItems, int index, int k)
+{
+	if (k <= nodeCount)
+	{
+		index = fillLayout(sortedItems, index, 2 * k);
+		layout[k] = sortedItems[index++];
+		index = fillLayout(sortedItems, index, 2 * k + 1);
+	}
+
+	return index;
+}
+
+template<class ItemType>
+int FrozenSearchTree<ItemType>::lowerBoundPosition(const ItemType& target) const
+{
+	if (nodeCount == 0) return 0;
+
+	const ItemType* base = layout.data();
+	unsigned int k = 1;
+
+	// Branchless descent : the comparison picks the child, so no branch depends on the data
+	while (k <= (unsigned int)nodeCount)
+	{
+		// Clamped to the last entry, so the address stays inside the buffer near the leaves
+		FROZEN_PREFETCH(base + min((size_t)k * prefetchStride, (size_t)nodeCount));
+		k = 2 * k + (unsigned int)(base[k] < target);
+	}
+
+	// The path went right (1 bits) past entries less than target; the last left turn is the answer.
+	// Dropping the trailing ones and that final zero recovers it (0 when every entry is less).
+	while (k & 1) k >>= 1;
+	k >>= 1;
+
+	return (int)k;
+} // End lowerBoundPosition()
+
+template<class ItemType>
+bool FrozenSearchTree<ItemType>::isEmpty() const
+{
+	return (nodeCount == 0);
+}
+
+template<class ItemType>
+int FrozenSearchTree<ItemType>::getNumberOfNodes() const
+{
+	return nodeCount;
+}
+
+template<class ItemType>
+const ItemType* FrozenSearchTree<ItemType>::lowerBound(const ItemType& target) const
+{
+	int k = lowerBoundPosition(target);
+	return (k == 0) ? nullptr : &layout[k];
+}
+
+template<class ItemType>
+ItemType FrozenSearchTree<ItemType>::getEntry(const ItemType& anEntry) const throw(NotFoundException)
+{
+	int k = lowerBoundPosition(anEntry);
+
+	if (k != 0 && !(anEntry < layout[k])) return layout[k];
+	throw NotFoundException("FrozenSearchTree::getEntry : Entry not found");
+}
+
+template<class ItemType>
+bool FrozenSearchTree<ItemType>::contains(const ItemType& anEntry) const
+{
+	int k = lowerBoundPosition(anEntry);
+	return (k != 0 && !(anEntry < layout[k]));
+}
+
+template<class ItemType>
+void FrozenSearchTree<ItemType>::inorderTraverse(void visit(ItemType&)) const
+{
+	if (nodeCount == 0) return;
+
+	// Start at the leftmost entry, then step to the inorder successor each time
+	int k = 1;
+	while (2 * k <= nodeCount) k = 2 * k;
+
+	while (k != 0)
+	{
+		ItemType theItem = layout[k];
+		visit(theItem);
+
+		if (2 * k + 1 <= nodeCount)
+		{
+			k = 2 * k + 1;
+			while (2 * k <= nodeCount) k = 2 * k;
+		}
+		else
+		{
+			// Climb while coming from a right child, then once more to the parent
+			while (k & 1) k >>= 1;
+			k >>= 1;
+		}
+	}
+} // End inorderTraverse()
+
+#endif
@@ -0,0 +1,698 @@
+#ifndef LOCK_FREE_SKIP_LIST_
+#define LOCK_FREE_SKIP_LIST_
+
+#include "BinaryTreeInterface.h"
+#include "PrecondViolatedExcept.h"
+#include "NotFoundException.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <random>
+#include <cstdint>
+#include <new>
+
+using namespace std;
+
+// Ordered multiset that any number of threads may add to, remove from and search at once, without locks.
+// The entries live in a skip list : every node is on the bottom level, and on each level above with probability 1/2,
+// so a search skips ahead in O(log n) expected steps.
+// Entries that compare equal share one node, which counts them, so every node holds a distinct key. A node whose
+// count drops to zero is marked in its links and unlinked, and a new node for that key is only linked once it is.
+// add, remove and contains are linearizable : at the change of a count, or at the read of one.
+// Removed nodes are freed once no operation started before their removal is still running (epoch based).
+// Each thread that uses a list holds one of maxThreads slots, shared by every list of the same item type.
+// A skip list has no tree shape : every traversal visits the entries in sorted order, equal entries together.
+template<class ItemType>
+class LockFreeSkipList : public BinaryTreeInterface<ItemType>
+{
+private:
+	static const int maxLevel = 24;
+	static const int maxThreads = 256;
+	static const int reclaimInterval = 64; // Retired nodes a thread collects before trying to free them
+
+	struct Node
+	{
+		ItemType item;
+		std::atomic<int> copyCount;     // Equal entries held; 0 once the node is being removed
+		std::atomic<int> pendingOwners; // The adding thread until every level is linked, the removing one until it is unlinked
+		int levelCount;
+		std::atomic<uintptr_t>* next;   // levelCount links, stored right after the node. Bit 0 marks the node removed at that level
+
+		Node(const ItemType& anItem, int levels) : item(anItem), copyCount(1), pendingOwners(2), levelCount(levels), next(nullptr) {}
+	};
+
+	struct ThreadSlot
+	{
+		std::atomic<unsigned long long> epoch; // 0 when the thread is outside an operation
+		std::atomic<bool> isClaimed;
+		char padding[64 - sizeof(std::atomic<unsigned long long>) - sizeof(std::atomic<bool>)];
+
+		ThreadSlot() : epoch(0), isClaimed(false) {}
+	};
+
+	struct RetiredNode
+	{
+		unsigned long long epoch;
+		Node* nodePtr;
+	};
+
+	// The slots and the retired nodes of threads that have exited.
+	struct EpochDomain
+	{
+		ThreadSlot slots[maxThreads];
+		std::atomic<unsigned long long> globalEpoch;
+		std::mutex orphanMutex;
+		vector<RetiredNode> orphans;
+
+		EpochDomain() : globalEpoch(1) {}
+		~EpochDomain();
+	};
+
+	// One thread's slot, the nodes it retired and its level generator. Released when the thread exits.
+	struct ThreadRecord
+	{
+		ThreadSlot* slotPtr;
+		int sectionDepth;
+		vector<RetiredNode> retired;
+		std::mt19937 generator;
+
+		ThreadRecord() throw(PrecondViolatedExcept);
+		~ThreadRecord();
+	};
+
+	// Announces the calling thread for the duration of an operation, so that the nodes it may reach stay allocated.
+	class OperationSection
+	{
+	private:
+		ThreadRecord& record;
+
+	public:
+		OperationSection();
+		~OperationSection();
+	};
+
+	Node* headPtr; // Sentinel with maxLevel links; its item is never compared
+	std::atomic<int> entryCount;
+
+	static EpochDomain& getDomain();
+	static ThreadRecord& getThreadRecord();
+
+	// Adds nodePtr to the calling thread's retired nodes, to be freed once no running operation can reach it.
+	static void retireNode(Node* nodePtr);
+
+	// Frees the retired nodes that every running operation started after.
+	static void reclaim(vector<RetiredNode>& retired);
+
+	static Node* createNode(const ItemType& anItem, int levels);
+	static void destroyNode(Node* nodePtr);
+
+	static Node* pointerOf(uintptr_t link) { return reinterpret_cast<Node*>(link & ~(uintptr_t)1); }
+	static bool isMarked(uintptr_t link) { return (link & 1) != 0; }
+
+	static int randomLevel();
+
+	// Fills predecessors and successors with the nodes around target on every level, unlinking marked nodes on the way.
+	// Returns false if an unlink lost a race, in which case the search must start over.
+	bool tryFind(const ItemType& target, Node** predecessors, Node** successors) const;
+
+	// Returns the node holding target, or nullptr, after filling predecessors and successors.
+	Node* find(const ItemType& target, Node** predecessors, Node** successors) const;
+
+	// Marks every link of nodePtr, top level first. The bottom mark makes the node unreachable for new searches.
+	static void markNode(Node* nodePtr);
+
+	// Unlinks a node whose count has reached zero, then drops the calling thread's claim on it.
+	void unlinkNode(Node* nodePtr);
+
+	// Drops one of the two claims on nodePtr, retiring it once both are gone.
+	static void releaseNode(Node* nodePtr);
+
+	// Returns the first node holding a key not less than target, without unlinking anything.
+	Node* lowerBound(const ItemType& target) const;
+
+	// Visits the entries in sorted order, each one as often as it was added.
+	void traverse(void visit(ItemType&)) const;
+
+public:
+	//------------------------------------------------------------
+	// Constructor and Destructor Section.
+	//------------------------------------------------------------
+	LockFreeSkipList();
+
+	// @pre  No other thread is using the list.
+	virtual ~LockFreeSkipList();
+
+	LockFreeSkipList(const LockFreeSkipList&) = delete;
+	LockFreeSkipList& operator=(const LockFreeSkipList&) = delete;
+
+	//------------------------------------------------------------
+	// Public BinaryTreeInterface Methods Section.
+	//------------------------------------------------------------
+	bool isEmpty() const;
+
+	// The number of skip list levels in use.
+	int getHeight() const;
+	int getNumberOfNodes() const;
+
+	// There is no root : returns the smallest entry.
+	ItemType getRootData() const throw(PrecondViolatedExcept);
+
+	// Always throws : replacing an entry in place could break the order.
+	void setRootData(const ItemType& newData) throw(PrecondViolatedExcept);
+
+	bool add(const ItemType& newData);
+	bool remove(const ItemType& target);
+
+	// Removes the entries one at a time, so other threads may keep using the list meanwhile.
+	void clear();
+
+	ItemType getEntry(const ItemType& anEntry) const throw(NotFoundException);
+	bool contains(const ItemType& anEntry) const;
+
+	//------------------------------------------------------------
+	// Public Traversals Section.
+	// Entries added or removed during a traversal may or may not be visited.
+	//------------------------------------------------------------
+	void preorderTraverse(void visit(ItemType&)) const;
+	void inorderTraverse(void visit(ItemType&)) const;
+	void postorderTraverse(void visit(ItemType&)) const;
+	void generalOrderTraverse(void visit(ItemType&)) const;
+	void linearOrderTraverse(void visit(ItemType&)) const;
+}; // end LockFreeSkipList
+
+   // -------------------Definitons----------------------------
+template<class ItemType>
+LockFreeSkipList<ItemType>::EpochDomain::~EpochDomain()
+{
+	for (size_t i = 0; i < orphans.size(); i++)
+		destroyNode(orphans[i].nodePtr);
+}
+
+template<class ItemType>
+LockFreeSkipList<ItemType>::ThreadRecord::ThreadRecord() throw(PrecondViolatedExcept) : slotPtr(nullptr), sectionDepth(0)
+{
+	EpochDomain& domain = getDomain();
+
+	for (int i = 0; i < maxThreads && slotPtr == nullptr; i++)
+	{
+		bool isClaimed = false;
+		if (domain.slots[i].isClaimed.compare_exchange_strong(isClaimed, true)) slotPtr = &domain.slots[i];
+	}
+
+	if (slotPtr == nullptr) throw PrecondViolatedExcept("LockFreeSkipList : More than maxThreads threads use the list");
+
+	generator.seed((unsigned int)std::hash<std::thread::id>()(std::this_thread::get_id()) ^ (unsigned int)(uintptr_t)slotPtr);
+}
+
+template<class ItemType>
+LockFreeSkipList<ItemType>::ThreadRecord::~ThreadRecord()
+{
+	EpochDomain& domain = getDomain();
+
+	// Nodes still reachable by other threads' operations are handed to the domain
+	reclaim(retired);
+	if (!retired.empty())
+	{
+		std::lock_guard<std::mutex> lock(domain.orphanMutex);
+		domain.orphans.insert(domain.orphans.end(), retired.begin(), retired.end());
+	}
+
+	slotPtr->isClaimed.store(false);
+}
+
+template<class ItemType>
+LockFreeSkipList<ItemType>::OperationSection::OperationSection() : record(getThreadRecord())
+{
+	// Sequentially consistent, so the announcement is visible before any link is read
+	if (record.sectionDepth++ == 0) record.slotPtr->epoch.store(getDomain().globalEpoch.load());
+}
+
+template<class ItemType>
+LockFreeSkipList<ItemType>::OperationSection::~OperationSection()
+{
+	if (--record.sectionDepth > 0) return;
+
+	record.slotPtr->epoch.store(0, std::memory_order_release);
+	if ((int)record.retired.size() >= reclaimInterval) reclaim(record.retired);
+}
+
+template<class ItemType>
+typename LockFreeSkipList<ItemType>::EpochDomain& LockFreeSkipList<ItemType>::getDomain()
+{
+	static EpochDomain domain;
+	return domain;
+}
+
+template<class ItemType>
+typename LockFreeSkipList<ItemType>::ThreadRecord& LockFreeSkipList<ItemType>::getThreadRecord()
+{
+	static thread_local ThreadRecord record;
+	return record;
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::retireNode(Node* nodePtr)
+{
+	RetiredNode retiredNode = { getDomain().globalEpoch.load(), nodePtr };
+	getThreadRecord().retired.push_back(retiredNode);
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::reclaim(vector<RetiredNode>& retired)
+{
+	EpochDomain& domain = getDomain();
+
+	// Operations announcing a later epoch started after every node retired so far was unlinked
+	domain.globalEpoch.fetch_add(1);
+	unsigned long long oldestEpoch = domain.globalEpoch.load();
+
+	for (int i = 0; i < maxThreads; i++)
+	{
+		unsigned long long threadEpoch = domain.slots[i].epoch.load();
+		if (threadEpoch != 0 && threadEpoch < oldestEpoch) oldestEpoch = threadEpoch;
+	}
+
+	size_t kept = 0;
+	for (size_t i = 0; i < retired.size(); i++)
+	{
+		if (retired[i].epoch < oldestEpoch)
+			destroyNode(retired[i].nodePtr);
+		else
+			retired[kept++] = retired[i];
+	}
+	retired.resize(kept);
+
+	// Exited threads' nodes are collected whenever no other thread is at it
+	std::unique_lock<std::mutex> lock(domain.orphanMutex, std::try_to_lock);
+	if (lock.owns_lock() && &retired != &domain.orphans && !domain.orphans.empty())
+	{
+		kept = 0;
+		for (size_t i = 0; i < domain.orphans.size(); i++)
+		{
+			if (domain.orphans[i].epoch < oldestEpoch)
+				destroyNode(domain.orphans[i].nodePtr);
+			else
+				domain.orphans[kept++] = domain.orphans[i];
+		}
+		domain.orphans.resize(kept);
+	}
+} // End reclaim()
+
+template<class ItemType>
+typename LockFreeSkipList<ItemType>::Node* LockFreeSkipList<ItemType>::createNode(const ItemType& anItem, int levels)
+{
+	// The links follow the node in the same block
+	const size_t linkAlignment = alignof(std::atomic<uintptr_t>);
+	const size_t nodeBytes = (sizeof(Node) + linkAlignment - 1) / linkAlignment * linkAlignment;
+	char* memory = static_cast<char*>(::operator new(nodeBytes + levels * sizeof(std::atomic<uintptr_t>)));
+	Node* nodePtr;
+
+	try
+	{
+		nodePtr = new (memory) Node(anItem, levels);
+	}
+	catch (...)
+	{
+		::operator delete(memory);
+		throw;
+	}
+
+	nodePtr->next = reinterpret_cast<std::atomic<uintptr_t>*>(memory + nodeBytes);
+	for (int level = 0; level < levels; level++)
+		new (&nodePtr->next[level]) std::atomic<uintptr_t>(0);
+
+	return nodePtr;
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::destroyNode(Node* nodePtr)
+{
+	nodePtr->~Node();
+	::operator delete(nodePtr);
+}
+
+template<class ItemType>
+int LockFreeSkipList<ItemType>::randomLevel()
+{
+	unsigned int bits = getThreadRecord().generator();
+	int levels = 1;
+
+	while ((bits & 1) && levels < maxLevel)
+	{
+		levels++;
+		bits >>= 1;
+	}
+
+	return levels;
+}
+
+template<class ItemType>
+LockFreeSkipList<ItemType>::LockFreeSkipList() : headPtr(createNode(ItemType(), maxLevel)), entryCount(0) {}
+
+template<class ItemType>
+LockFreeSkipList<ItemType>::~LockFreeSkipList()
+{
+	// Nodes that were retired belong to the epoch domain; the ones still linked are freed here
+	Node* nodePtr = pointerOf(headPtr->next[0].load());
+
+	while (nodePtr != nullptr)
+	{
+		Node* nextPtr = pointerOf(nodePtr->next[0].load());
+		destroyNode(nodePtr);
+		nodePtr = nextPtr;
+	}
+
+	destroyNode(headPtr);
+}
+
+template<class ItemType>
+bool LockFreeSkipList<ItemType>::tryFind(const ItemType& target, Node** predecessors, Node** successors) const
+{
+	Node* predPtr = headPtr;
+
+	for (int level = maxLevel - 1; level >= 0; level--)
+	{
+		Node* currPtr = pointerOf(predPtr->next[level].load());
+
+		while (currPtr != nullptr)
+		{
+			uintptr_t succLink = currPtr->next[level].load();
+
+			if (isMarked(succLink))
+			{
+				// currPtr is removed on this level : unlink it, unless predPtr changed in the meantime
+				uintptr_t expected = reinterpret_cast<uintptr_t>(currPtr);
+				if (!predPtr->next[level].compare_exchange_strong(expected, succLink & ~(uintptr_t)1)) return false;
+
+				currPtr = pointerOf(succLink);
+			}
+			else if (currPtr->item < target)
+			{
+				predPtr = currPtr;
+				currPtr = pointerOf(succLink);
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		predecessors[level] = predPtr;
+		successors[level] = currPtr;
+	}
+
+	return true;
+} // End tryFind()
+
+template<class ItemType>
+typename LockFreeSkipList<ItemType>::Node* LockFreeSkipList<ItemType>::find(const ItemType& target, Node** predecessors, Node** successors) const
+{
+	while (!tryFind(target, predecessors, successors)) {}
+
+	Node* nodePtr = successors[0];
+	return (nodePtr != nullptr && !(target < nodePtr->item)) ? nodePtr : nullptr;
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::markNode(Node* nodePtr)
+{
+	for (int level = nodePtr->levelCount - 1; level >= 0; level--)
+	{
+		uintptr_t link = nodePtr->next[level].load();
+		while (!isMarked(link) && !nodePtr->next[level].compare_exchange_weak(link, link | 1)) {}
+	}
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::unlinkNode(Node* nodePtr)
+{
+	Node* predecessors[maxLevel];
+	Node* successors[maxLevel];
+
+	markNode(nodePtr);
+	find(nodePtr->item, predecessors, successors); // Unlinks the marked node on every level it is linked on
+	releaseNode(nodePtr);
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::releaseNode(Node* nodePtr)
+{
+	if (nodePtr->pendingOwners.fetch_sub(1) == 1) retireNode(nodePtr);
+}
+
+template<class ItemType>
+bool LockFreeSkipList<ItemType>::add(const ItemType& newData)
+{
+	OperationSection section;
+	Node* predecessors[maxLevel];
+	Node* successors[maxLevel];
+	Node* newNodePtr = nullptr;
+
+	while (true)
+	{
+		Node* nodePtr = find(newData, predecessors, successors);
+
+		if (nodePtr != nullptr)
+		{
+			// The key is there : count one more entry, unless the node is already on its way out
+			int count = nodePtr->copyCount.load();
+			while (count > 0 && !nodePtr->copyCount.compare_exchange_weak(count, count + 1)) {}
+
+			if (count > 0)
+			{
+				if (newNodePtr != nullptr) destroyNode(newNodePtr);
+				entryCount.fetch_add(1);
+				return true;
+			}
+
+			// Help unlink the dead node, so the next search can place a new one
+			markNode(nodePtr);
+			continue;
+		}
+
+		if (newNodePtr == nullptr) newNodePtr = createNode(newData, randomLevel());
+
+		for (int level = 0; level < newNodePtr->levelCount; level++)
+			newNodePtr->next[level].store(reinterpret_cast<uintptr_t>(successors[level]), std::memory_order_relaxed);
+
+		// Linking the bottom level adds the entry
+		uintptr_t expected = reinterpret_cast<uintptr_t>(successors[0]);
+		if (predecessors[0]->next[0].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(newNodePtr))) break;
+	}
+
+	entryCount.fetch_add(1);
+
+	// The levels above only speed up searches. Stop linking once the node is being removed
+	for (int level = 1; level < newNodePtr->levelCount; level++)
+	{
+		while (true)
+		{
+			uintptr_t link = newNodePtr->next[level].load();
+			if (isMarked(link)) break;
+
+			Node* succPtr = successors[level];
+			if (pointerOf(link) != succPtr && !newNodePtr->next[level].compare_exchange_strong(link, reinterpret_cast<uintptr_t>(succPtr))) break;
+
+			uintptr_t expected = reinterpret_cast<uintptr_t>(succPtr);
+			if (predecessors[level]->next[level].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(newNodePtr))) break;
+
+			find(newData, predecessors, successors);
+		}
+
+		if (isMarked(newNodePtr->next[level].load())) break;
+	}
+
+	// A removal may have run its unlinking search before a level above was linked : search again to unlink it
+	if (isMarked(newNodePtr->next[0].load())) find(newData, predecessors, successors);
+
+	releaseNode(newNodePtr);
+	return true;
+} // End add()
+
+template<class ItemType>
+bool LockFreeSkipList<ItemType>::remove(const ItemType& target)
+{
+	OperationSection section;
+	Node* predecessors[maxLevel];
+	Node* successors[maxLevel];
+
+	Node* nodePtr = find(target, predecessors, successors);
+	if (nodePtr == nullptr) return false;
+
+	int count = nodePtr->copyCount.load();
+	while (count > 0 && !nodePtr->copyCount.compare_exchange_weak(count, count - 1)) {}
+
+	if (count == 0) return false; // Its last entry was removed just before
+	entryCount.fetch_sub(1);
+
+	// The thread that takes the count to zero unlinks the node
+	if (count == 1) unlinkNode(nodePtr);
+
+	return true;
+} // End remove()
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::clear()
+{
+	OperationSection section;
+
+	while (true)
+	{
+		Node* nodePtr = pointerOf(headPtr->next[0].load());
+		while (nodePtr != nullptr && nodePtr->copyCount.load() == 0)
+			nodePtr = pointerOf(nodePtr->next[0].load());
+
+		if (nodePtr == nullptr) return;
+
+		int count = nodePtr->copyCount.load();
+		while (count > 0 && !nodePtr->copyCount.compare_exchange_weak(count, 0)) {}
+
+		if (count > 0)
+		{
+			entryCount.fetch_sub(count);
+			unlinkNode(nodePtr);
+		}
+	}
+} // End clear()
+
+template<class ItemType>
+typename LockFreeSkipList<ItemType>::Node* LockFreeSkipList<ItemType>::lowerBound(const ItemType& target) const
+{
+	Node* predPtr = headPtr;
+	Node* currPtr = nullptr;
+
+	for (int level = maxLevel - 1; level >= 0; level--)
+	{
+		currPtr = pointerOf(predPtr->next[level].load());
+
+		while (currPtr != nullptr)
+		{
+			uintptr_t succLink = currPtr->next[level].load();
+
+			if (isMarked(succLink))
+				currPtr = pointerOf(succLink); // Step over removed nodes without unlinking them
+			else if (currPtr->item < target)
+			{
+				predPtr = currPtr;
+				currPtr = pointerOf(succLink);
+			}
+			else
+				break;
+		}
+	}
+
+	return currPtr;
+}
+
+template<class ItemType>
+bool LockFreeSkipList<ItemType>::contains(const ItemType& anEntry) const
+{
+	OperationSection section;
+	Node* nodePtr = lowerBound(anEntry);
+
+	return (nodePtr != nullptr && !(anEntry < nodePtr->item) && nodePtr->copyCount.load() > 0);
+}
+
+template<class ItemType>
+ItemType LockFreeSkipList<ItemType>::getEntry(const ItemType& anEntry) const throw(NotFoundException)
+{
+	OperationSection section;
+	Node* nodePtr = lowerBound(anEntry);
+
+	if (nodePtr != nullptr && !(anEntry < nodePtr->item) && nodePtr->copyCount.load() > 0) return nodePtr->item;
+	throw NotFoundException("LockFreeSkipList::getEntry : Entry not found");
+}
+
+template<class ItemType>
+bool LockFreeSkipList<ItemType>::isEmpty() const
+{
+	OperationSection section;
+
+	for (Node* nodePtr = pointerOf(headPtr->next[0].load()); nodePtr != nullptr; nodePtr = pointerOf(nodePtr->next[0].load()))
+	{
+		if (nodePtr->copyCount.load() > 0) return false;
+	}
+
+	return true;
+}
+
+template<class ItemType>
+int LockFreeSkipList<ItemType>::getHeight() const
+{
+	int level = maxLevel;
+	while (level > 0 && pointerOf(headPtr->next[level - 1].load()) == nullptr) level--;
+
+	return level;
+}
+
+template<class ItemType>
+int LockFreeSkipList<ItemType>::getNumberOfNodes() const
+{
+	return entryCount.load();
+}
+
+template<class ItemType>
+ItemType LockFreeSkipList<ItemType>::getRootData() const throw(PrecondViolatedExcept)
+{
+	OperationSection section;
+
+	for (Node* nodePtr = pointerOf(headPtr->next[0].load()); nodePtr != nullptr; nodePtr = pointerOf(nodePtr->next[0].load()))
+	{
+		if (nodePtr->copyCount.load() > 0) return nodePtr->item;
+	}
+
+	throw PrecondViolatedExcept("LockFreeSkipList::getRootData : The list is empty");
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::setRootData(const ItemType& /* newData */) throw(PrecondViolatedExcept)
+{
+	throw PrecondViolatedExcept("LockFreeSkipList::setRootData : The entries have no root to replace");
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::traverse(void visit(ItemType&)) const
+{
+	OperationSection section;
+
+	for (Node* nodePtr = pointerOf(headPtr->next[0].load()); nodePtr != nullptr; nodePtr = pointerOf(nodePtr->next[0].load()))
+	{
+		for (int count = nodePtr->copyCount.load(); count > 0; count--)
+		{
+			ItemType theItem = nodePtr->item;
+			visit(theItem);
+		}
+	}
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::preorderTraverse(void visit(ItemType&)) const
+{
+	traverse(visit);
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::inorderTraverse(void visit(ItemType&)) const
+{
+	traverse(visit);
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::postorderTraverse(void visit(ItemType&)) const
+{
+	traverse(visit);
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::generalOrderTraverse(void visit(ItemType&)) const
+{
+	traverse(visit);
+}
+
+template<class ItemType>
+void LockFreeSkipList<ItemType>::linearOrderTraverse(void visit(ItemType&)) const
+{
+	traverse(visit);
+}
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef NODE_POOL_
+#define NODE_POOL_
+
+#include "General.h"
+#include <cstddef>
+
+// Slab pool for tree nodes.
+// Blocks of a single size are carved from contiguous chunks, and freed blocks are recycled through a free list.
+// The pool is not thread safe : each tree owns its own pool.
+class NodePool
+{
+private:
+	struct FreeBlock { FreeBlock* next; };
+
+	// Only ever read by value: these have no out-of-line definition, so binding one to a reference
+	// (as min() would) fails to link in unoptimized builds.
+	static const size_t firstChunkBlocks = 64;
+	static const size_t maxChunkBlocks = 4096;
+
+	size_t blockSize;       // Set by the first allocation
+	size_t nextChunkBlocks;
+	vector<char*> chunks;
+	char* chunkCursor;      // Next never-used block of the newest chunk
+	char* chunkEnd;
+	FreeBlock* freeList;
+
+	long long allocationCount;
+	long long liveCount;
+	long long bytesReserved;
+
+	void addChunk()
+	{
+		size_t chunkBytes = blockSize * nextChunkBlocks;
+		char* chunk = static_cast<char*>(::operator new(chunkBytes));
+
+		chunks.push_back(chunk);
+		chunkCursor = chunk;
+		chunkEnd = chunk + chunkBytes;
+		bytesReserved += chunkBytes;
+
+		nextChunkBlocks = min(nextChunkBlocks * 2, (size_t)maxChunkBlocks);
+	}
+
+public:
+	NodePool() : blockSize(0), nextChunkBlocks(firstChunkBlocks), chunkCursor(nullptr), chunkEnd(nullptr), freeList(nullptr),
+		allocationCount(0), liveCount(0), bytesReserved(0) {}
+
+	~NodePool()
+	{
+		for (size_t i = 0; i < chunks.size(); i++)
+			::operator delete(chunks[i]);
+	}
+
+	NodePool(const NodePool&) = delete;
+	NodePool& operator=(const NodePool&) = delete;
+
+	// Tests whether blocks of the given size come from this pool.
+	bool serves(size_t bytes)
+	{
+		size_t alignment = alignof(std::max_align_t);
+		size_t rounded = (max(bytes, sizeof(FreeBlock)) + alignment - 1) / alignment * alignment;
+
+		if (blockSize == 0) blockSize = rounded;
+		return (rounded == blockSize);
+	}
+
+	void* allocate()
+	{
+		void* block;
+
+		if (freeList != nullptr)
+		{
+			block = freeList;
+			freeList = freeList->next;
+		}
+		else
+		{
+			if (chunkCursor == chunkEnd) addChunk();
+
+			block = chunkCursor;
+			chunkCursor += blockSize;
+		}
+
+		allocationCount++;
+		liveCount++;
+		return block;
+	}
+
+	void deallocate(void* block)
+	{
+		FreeBlock* freedBlock = static_cast<FreeBlock*>(block);
+		freedBlock->next = freeList;
+		freeList = freedBlock;
+
+		liveCount--;
+	}
+
+	// Returns every chunk to the system at once. Does nothing while blocks are still in use.
+	void release()
+	{
+		if (liveCount != 0) return;
+
+		for (size_t i = 0; i < chunks.size(); i++)
+			::operator delete(chunks[i]);
+
+		chunks.clear();
+		chunkCursor = chunkEnd = nullptr;
+		freeList = nullptr;
+		nextChunkBlocks = firstChunkBlocks;
+		bytesReserved = 0;
+	}
+
+	long long getAllocationCount() const { return allocationCount; }       // Blocks handed out so far
+	long long getLiveCount() const { return liveCount; }                   // Blocks currently in use
+	long long getChunkCount() const { return (long long)chunks.size(); }   // Allocations requested from the system
+	long long getBytesReserved() const { return bytesReserved; }           // Bytes held in chunks
+	long long getBytesInUse() const { return liveCount * (long long)blockSize; }
+}; // end NodePool
+
+// Standard allocator drawing from a NodePool, for BinaryNodeTree<ItemType, NodeAllocator> and
+// BinarySearchTree<ItemType, BalancePolicy, NodeAllocator>.
+// Copies (and rebound copies, such as the one std::allocate_shared keeps in each control block) share
+// the pool, which lives until the last node allocated from it is freed.
+template<class T>
+class NodePoolAllocator
+{
+private:
+	std::shared_ptr<NodePool> pool;
+
+	template<class U> friend class NodePoolAllocator;
+
+public:
+	typedef T value_type;
+
+	NodePoolAllocator() : pool(std::make_shared<NodePool>()) {}
+
+	template<class U>
+	NodePoolAllocator(const NodePoolAllocator<U>& other) : pool(other.pool) {}
+
+	T* allocate(size_t n)
+	{
+		if (n == 1 && pool->serves(sizeof(T)))
+			return static_cast<T*>(pool->allocate());
+
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+
+	void deallocate(T* block, size_t n)
+	{
+		if (n == 1 && pool->serves(sizeof(T)))
+			pool->deallocate(block);
+		else
+			::operator delete(block);
+	}
+
+	// Returns the pool's chunks to the system once every node has been freed.
+	void release() { pool->release(); }
+
+	const NodePool& getPool() const { return *pool; }
+
+	template<class U>
+	bool operator==(const NodePoolAllocator<U>& other) const { return pool == other.pool; }
+
+	template<class U>
+	bool operator!=(const NodePoolAllocator<U>& other) const { return pool != other.pool; }
+}; // end NodePoolAllocator
+
+// Lets a tree hand its memory back on clear() whatever its allocator : a no-op for other allocators.
+// Called once the nodes are destroyed, so it only spares the frees : it cannot skip the node walk.
+template<class Allocator>
+void releaseNodeMemory(Allocator& /* allocator */) {}
+
+template<class T>
+void releaseNodeMemory(NodePoolAllocator<T>& allocator) { allocator.release(); }
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef PARALLEL_SORT_
+#define PARALLEL_SORT_
+
+#include "General.h"
+#include "WorkStealingPool.h"
+#include <iterator>
+
+using namespace std;
+
+// Stable merge sort on a WorkStealingPool, for the bulk builds of large unsorted ranges.
+// The halves of each range are sorted by different tasks, then merged by splitting the output too :
+// the larger run is cut at its middle item, the other run at the matching position found by binary search,
+// and the two pieces are merged by different tasks. The sort moves items between the vector and one buffer
+// of the same size, alternating level by level, so each level moves every item once.
+template<class T>
+class ParallelSorter
+{
+private:
+	WorkStealingPool& pool;
+	size_t grainSize; // At least 2, so that each split of a merge shrinks both pieces
+
+	ParallelSorter(WorkStealingPool& taskPool, size_t taskGrainSize) : pool(taskPool), grainSize(taskGrainSize) {}
+
+	// Sorts items[0, count). The result ends in buffer if isToBuffer, or else in items.
+	void sortInto(T* items, T* buffer, size_t count, bool isToBuffer)
+	{
+		if (count <= grainSize)
+		{
+			std::stable_sort(items, items + count);
+			if (isToBuffer) std::move(items, items + count, buffer);
+			return;
+		}
+
+		size_t half = count / 2;
+
+		// The halves end in the other array, to be merged back into this one
+		WorkStealingPool::TaskGroup group(pool);
+		group.run([=]() { sortInto(items, buffer, half, !isToBuffer); });
+		sortInto(items + half, buffer + half, count - half, !isToBuffer);
+		group.wait();
+
+		if (isToBuffer)
+			merge(items, items + half, items + half, items + count, buffer);
+		else
+			merge(buffer, buffer + half, buffer + half, buffer + count, items);
+	} // End sortInto()
+
+	// Merges the sorted runs [first1, last1) and [first2, last2) into output, moving the items.
+	// Equal items of the first run come first.
+	void merge(T* first1, T* last1, T* first2, T* last2, T* output)
+	{
+		size_t count1 = last1 - first1;
+		size_t count2 = last2 - first2;
+
+		if (count1 + count2 <= grainSize)
+		{
+			std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1),
+				std::make_move_iterator(first2), std::make_move_iterator(last2), output);
+			return;
+		}
+
+		T* split1;
+		T* split2;
+
+		if (count1 >= count2)
+		{
+			split1 = first1 + count1 / 2;
+			split2 = std::lower_bound(first2, last2, *split1); // Items equal to *split1 stay after it
+		}
+		else
+		{
+			split2 = first2 + count2 / 2;
+			split1 = std::upper_bound(first1, last1, *split2); // Items equal to *split2 stay before it
+		}
+
+		T* splitOutput = output + (split1 - first1) + (split2 - first2);
+
+		WorkStealingPool::TaskGroup group(pool);
+		group.run([=]() { merge(first1, split1, first2, split2, output); });
+		merge(split1, last1, split2, last2, splitOutput);
+		group.wait();
+	} // End merge()
+
+	// Moves the first item of each run of equal items of the sorted items to the front of output,
+	// and returns how many were moved. One task marks and counts each chunk of grainSize items, then
+	// one task per chunk moves its marked items to the offset the counts before it add up to.
+	size_t moveUnique(vector<T>& items, vector<T>& output)
+	{
+		size_t chunkCount = (items.size() + grainSize - 1) / grainSize;
+		vector<char> isKept(items.size());
+		vector<size_t> chunkOffsets(chunkCount + 1, 0);
+
+		forEachChunk(chunkCount, [&](size_t chunk)
+		{
+			size_t last = min(items.size(), (chunk + 1) * grainSize);
+
+			for (size_t i = chunk * grainSize; i < last; i++)
+			{
+				isKept[i] = (i == 0 || items[i - 1] < items[i]);
+				chunkOffsets[chunk + 1] += isKept[i];
+			}
+		});
+
+		for (size_t chunk = 0; chunk < chunkCount; chunk++)
+			chunkOffsets[chunk + 1] += chunkOffsets[chunk];
+
+		forEachChunk(chunkCount, [&](size_t chunk)
+		{
+			size_t last = min(items.size(), (chunk + 1) * grainSize);
+			size_t outputIndex = chunkOffsets[chunk];
+
+			for (size_t i = chunk * grainSize; i < last; i++)
+			{
+				if (isKept[i]) output[outputIndex++] = std::move(items[i]);
+			}
+		});
+
+		return chunkOffsets[chunkCount];
+	} // End moveUnique()
+
+	// Calls work(chunk) for each chunk in [0, chunkCount), one task per chunk.
+	template<class Work>
+	void forEachChunk(size_t chunkCount, const Work& work)
+	{
+		WorkStealingPool::TaskGroup group(pool);
+
+		for (size_t chunk = 1; chunk < chunkCount; chunk++)
+			group.run([&work, chunk]() { work(chunk); });
+
+		if (chunkCount > 0) work(0);
+		group.wait();
+	}
+
+	// Leaves the unique items of the sorted items in items, using buffer as scratch space of the same size.
+	void keepUnique(vector<T>& items, vector<T>& buffer)
+	{
+		size_t uniqueCount = moveUnique(items, buffer);
+
+		buffer.erase(buffer.begin() + uniqueCount, buffer.end());
+		items.swap(buffer);
+	}
+
+public:
+	// Sorts items stably with the pool's threads. Ranges of grainSize items or fewer are sorted by one task.
+	// If dropDuplicates, only the first of each run of equal items is kept.
+	// @pre  T is default constructible (the sort works through a buffer of items.size() entries).
+	static void sort(vector<T>& items, bool dropDuplicates, WorkStealingPool& pool = WorkStealingPool::getDefault(),
+		size_t grainSize = 1 << 14)
+	{
+		ParallelSorter sorter(pool, max(grainSize, (size_t)2));
+		vector<T> buffer(items.size());
+
+		sorter.sortInto(items.data(), buffer.data(), items.size(), false);
+
+		if (dropDuplicates) sorter.keepUnique(items, buffer);
+	}
+
+	// Keeps the first of each run of equal items of the sorted items, as sort() does.
+	static void removeDuplicates(vector<T>& items, WorkStealingPool& pool = WorkStealingPool::getDefault(),
+		size_t grainSize = 1 << 14)
+	{
+		ParallelSorter sorter(pool, max(grainSize, (size_t)2));
+		vector<T> buffer(items.size());
+
+		sorter.keepUnique(items, buffer);
+	}
+}; // end ParallelSorter
+
+#endif
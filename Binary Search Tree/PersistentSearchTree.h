@@ -0,0 +1,328 @@
+#ifndef PERSISTENT_SEARCH_TREE_
+#define PERSISTENT_SEARCH_TREE_
+
+#include "BinaryNode.h"
+#include "NotFoundException.h"
+#include "TreeIterator.h"
+
+using namespace std;
+
+// Read-only version of a PersistentSearchTree, as returned by snapshot().
+// A snapshot shares its nodes with the tree and with every other snapshot, and no node is ever changed once it
+// is linked, so a snapshot keeps showing the entries it was taken with while the tree goes on changing.
+// Nodes no version can reach any more are freed with their last shared_ptr.
+// Node counts are atomic, so a snapshot may be read on another thread while the tree keeps writing.
+template<class ItemType>
+class SearchTreeSnapshot
+{
+protected:
+	NodeUnit rootPtr;
+
+	explicit SearchTreeSnapshot(NodeUnit treePtr) : rootPtr(std::move(treePtr)) {}
+
+	template<class> friend class PersistentSearchTree;
+	template<class> friend class ConcurrentSearchTree;
+
+public:
+	typedef TreeIterator<ItemType> iterator;
+	typedef TreeIterator<ItemType> const_iterator;
+
+	//------------------------------------------------------------
+	// Constructor Section.
+	//------------------------------------------------------------
+	SearchTreeSnapshot() {}
+
+	//------------------------------------------------------------
+	// Public Methods Section.
+	//------------------------------------------------------------
+	bool isEmpty() const;
+	int getHeight() const;
+	int getNumberOfNodes() const;
+
+	ItemType getEntry(const ItemType& anEntry) const throw(NotFoundException);
+	bool contains(const ItemType& anEntry) const;
+
+	// Visits the entries in sorted order.
+	void inorderTraverse(void visit(ItemType&)) const;
+
+	// Inorder iterators (see TreeIterator.h). They stay valid as long as this version does.
+	iterator begin() const;
+	iterator end() const;
+}; // end SearchTreeSnapshot
+
+// Binary search tree whose versions share structure.
+// Nodes are never changed in place : add() and remove() copy the nodes on the path from the root to the change
+// and link the copies to the untouched subtrees, so a write allocates O(log n) nodes and every earlier version
+// stays intact. The tree is kept AVL balanced by rebuilding the copied path.
+// snapshot() hands out the current version in O(1).
+// Nodes come from std::allocator : the last snapshot may be dropped on any thread, and NodePool is not thread safe.
+// The tree itself is not thread safe : only its snapshots may be handed to other threads
+// (ConcurrentSearchTree.h shares one tree between threads).
+template<class ItemType>
+class PersistentSearchTree : public SearchTreeSnapshot<ItemType>
+{
+private:
+	// Returns a new node holding anItem over the given subtrees.
+	static NodeUnit makeNode(const ItemType& anItem, NodeUnit leftPtr, NodeUnit rightPtr);
+
+	static int heightOf(const NodeUnit& subTreePtr);
+
+	// Makes a node over subtrees whose heights differ by two at most, rotating the copies so they differ by one at most.
+	static NodeUnit balancedNode(const ItemType& anItem, NodeUnit leftPtr, NodeUnit rightPtr);
+
+	// Return the root of the new version of the subtree. Entries are compared with operator<,
+	// and equal entries are placed to the right, as in BinarySearchTree.
+	static NodeUnit insertPath(const NodeUnit& subTreePtr, const ItemType& newEntry);
+	static NodeUnit removePath(const NodeUnit& subTreePtr, const ItemType& target, bool& isSuccessful);
+	static NodeUnit removeLeftmostPath(const NodeUnit& subTreePtr, ItemType& leftmostItem);
+
+public:
+	//------------------------------------------------------------
+	// Constructor Section.
+	//------------------------------------------------------------
+	PersistentSearchTree();
+
+	// Continues writing from an earlier version.
+	explicit PersistentSearchTree(const SearchTreeSnapshot<ItemType>& version);
+
+	//------------------------------------------------------------
+	// Public Methods Section.
+	//------------------------------------------------------------
+	bool add(const ItemType& newEntry);
+	bool remove(const ItemType& target);
+	void clear();
+
+	// Returns the current version in O(1). Later writes to the tree do not show in it.
+	SearchTreeSnapshot<ItemType> snapshot() const;
+}; // end PersistentSearchTree
+
+   // -------------------Definitons----------------------------
+template<class ItemType>
+bool SearchTreeSnapshot<ItemType>::isEmpty() const
+{
+	return (rootPtr.get() == nullptr);
+}
+
+template<class ItemType>
+int SearchTreeSnapshot<ItemType>::getHeight() const
+{
+	return (rootPtr.get() == nullptr) ? 0 : rootPtr->getHeight();
+}
+
+template<class ItemType>
+int SearchTreeSnapshot<ItemType>::getNumberOfNodes() const
+{
+	return (rootPtr.get() == nullptr) ? 0 : rootPtr->getNodeCount();
+}
+
+template<class ItemType>
+ItemType SearchTreeSnapshot<ItemType>::getEntry(const ItemType& anEntry) const throw(NotFoundException)
+{
+	const BinaryUnit* nodePtr = rootPtr.get();
+
+	while (nodePtr != nullptr)
+	{
+		if (anEntry < nodePtr->getItem())
+			nodePtr = nodePtr->getLeftChild();
+		else if (nodePtr->getItem() < anEntry)
+			nodePtr = nodePtr->getRightChild();
+		else
+			return nodePtr->getItem();
+	}
+
+	throw NotFoundException("SearchTreeSnapshot::getEntry : Entry not found");
+}
+
+template<class ItemType>
+bool SearchTreeSnapshot<ItemType>::contains(const ItemType& anEntry) const
+{
+	const BinaryUnit* nodePtr = rootPtr.get();
+
+	while (nodePtr != nullptr)
+	{
+		if (anEntry < nodePtr->getItem())
+			nodePtr = nodePtr->getLeftChild();
+		else if (nodePtr->getItem() < anEntry)
+			nodePtr = nodePtr->getRightChild();
+		else
+			return true;
+	}
+
+	return false;
+}
+
+template<class ItemType>
+void SearchTreeSnapshot<ItemType>::inorderTraverse(void visit(ItemType&)) const
+{
+	for (iterator entry = begin(); entry != end(); ++entry)
+	{
+		ItemType theItem = *entry;
+		visit(theItem);
+	}
+}
+
+template<class ItemType>
+typename SearchTreeSnapshot<ItemType>::iterator SearchTreeSnapshot<ItemType>::begin() const
+{
+	return iterator(rootPtr.get(), false);
+}
+
+template<class ItemType>
+typename SearchTreeSnapshot<ItemType>::iterator SearchTreeSnapshot<ItemType>::end() const
+{
+	return iterator(rootPtr.get(), true);
+}
+
+template<class ItemType>
+PersistentSearchTree<ItemType>::PersistentSearchTree() {}
+
+template<class ItemType>
+PersistentSearchTree<ItemType>::PersistentSearchTree(const SearchTreeSnapshot<ItemType>& version) :
+	SearchTreeSnapshot<ItemType>(version.rootPtr)
+{
+}
+
+template<class ItemType>
+NodeUnit PersistentSearchTree<ItemType>::makeNode(const ItemType& anItem, NodeUnit leftPtr, NodeUnit rightPtr)
+{
+	return std::make_shared<BinaryUnit>(anItem, std::move(leftPtr), std::move(rightPtr));
+}
+
+template<class ItemType>
+int PersistentSearchTree<ItemType>::heightOf(const NodeUnit& subTreePtr)
+{
+	return (subTreePtr.get() == nullptr) ? 0 : subTreePtr->getHeight();
+}
+
+template<class ItemType>
+NodeUnit PersistentSearchTree<ItemType>::balancedNode(const ItemType& anItem, NodeUnit leftPtr, NodeUnit rightPtr)
+{
+	int balance = heightOf(leftPtr) - heightOf(rightPtr);
+
+	if (balance > 1)
+	{
+		const BinaryUnit& left = *leftPtr;
+
+		// Left-right case : the left child's right subtree comes up
+		if (heightOf(left.getLeftChildPtr()) < heightOf(left.getRightChildPtr()))
+		{
+			const BinaryUnit& leftRight = *left.getRightChildPtr();
+
+			return makeNode(leftRight.getItem(),
+				makeNode(left.getItem(), left.getLeftChildPtr(), leftRight.getLeftChildPtr()),
+				makeNode(anItem, leftRight.getRightChildPtr(), std::move(rightPtr)));
+		}
+
+		return makeNode(left.getItem(), left.getLeftChildPtr(), makeNode(anItem, left.getRightChildPtr(), std::move(rightPtr)));
+	}
+
+	if (balance < -1)
+	{
+		const BinaryUnit& right = *rightPtr;
+
+		// Right-left case : the right child's left subtree comes up
+		if (heightOf(right.getRightChildPtr()) < heightOf(right.getLeftChildPtr()))
+		{
+			const BinaryUnit& rightLeft = *right.getLeftChildPtr();
+
+			return makeNode(rightLeft.getItem(),
+				makeNode(anItem, std::move(leftPtr), rightLeft.getLeftChildPtr()),
+				makeNode(right.getItem(), rightLeft.getRightChildPtr(), right.getRightChildPtr()));
+		}
+
+		return makeNode(right.getItem(), makeNode(anItem, std::move(leftPtr), right.getLeftChildPtr()), right.getRightChildPtr());
+	}
+
+	return makeNode(anItem, std::move(leftPtr), std::move(rightPtr));
+} // End balancedNode()
+
+template<class ItemType>
+NodeUnit PersistentSearchTree<ItemType>::insertPath(const NodeUnit& subTreePtr, const ItemType& newEntry)
+{
+	if (subTreePtr.get() == nullptr) return makeNode(newEntry, NodeUnit(), NodeUnit());
+
+	if (newEntry < subTreePtr->getItem())
+		return balancedNode(subTreePtr->getItem(), insertPath(subTreePtr->getLeftChildPtr(), newEntry), subTreePtr->getRightChildPtr());
+
+	return balancedNode(subTreePtr->getItem(), subTreePtr->getLeftChildPtr(), insertPath(subTreePtr->getRightChildPtr(), newEntry));
+}
+
+template<class ItemType>
+NodeUnit PersistentSearchTree<ItemType>::removePath(const NodeUnit& subTreePtr, const ItemType& target, bool& isSuccessful)
+{
+	if (subTreePtr.get() == nullptr)
+	{
+		isSuccessful = false;
+		return subTreePtr;
+	}
+
+	const BinaryUnit& node = *subTreePtr;
+
+	// A miss copies nothing : the subtree is handed back as it is
+	if (target < node.getItem())
+	{
+		NodeUnit leftPtr = removePath(node.getLeftChildPtr(), target, isSuccessful);
+		return isSuccessful ? balancedNode(node.getItem(), std::move(leftPtr), node.getRightChildPtr()) : subTreePtr;
+	}
+
+	if (node.getItem() < target)
+	{
+		NodeUnit rightPtr = removePath(node.getRightChildPtr(), target, isSuccessful);
+		return isSuccessful ? balancedNode(node.getItem(), node.getLeftChildPtr(), std::move(rightPtr)) : subTreePtr;
+	}
+
+	isSuccessful = true;
+
+	if (node.getLeftChildPtr().get() == nullptr) return node.getRightChildPtr();
+	if (node.getRightChildPtr().get() == nullptr) return node.getLeftChildPtr();
+
+	// Two children : the inorder successor takes the place of the removed entry
+	ItemType inorderSuccessor;
+	NodeUnit rightPtr = removeLeftmostPath(node.getRightChildPtr(), inorderSuccessor);
+
+	return balancedNode(inorderSuccessor, node.getLeftChildPtr(), std::move(rightPtr));
+} // End removePath()
+
+template<class ItemType>
+NodeUnit PersistentSearchTree<ItemType>::removeLeftmostPath(const NodeUnit& subTreePtr, ItemType& leftmostItem)
+{
+	if (subTreePtr->getLeftChildPtr().get() == nullptr)
+	{
+		leftmostItem = subTreePtr->getItem();
+		return subTreePtr->getRightChildPtr();
+	}
+
+	NodeUnit leftPtr = removeLeftmostPath(subTreePtr->getLeftChildPtr(), leftmostItem);
+	return balancedNode(subTreePtr->getItem(), std::move(leftPtr), subTreePtr->getRightChildPtr());
+}
+
+template<class ItemType>
+bool PersistentSearchTree<ItemType>::add(const ItemType& newEntry)
+{
+	this->rootPtr = insertPath(this->rootPtr, newEntry);
+	return true;
+}
+
+template<class ItemType>
+bool PersistentSearchTree<ItemType>::remove(const ItemType& target)
+{
+	bool isSuccessful = false;
+	NodeUnit newRootPtr = removePath(this->rootPtr, target, isSuccessful);
+
+	this->rootPtr = std::move(newRootPtr);
+	return isSuccessful;
+}
+
+template<class ItemType>
+void PersistentSearchTree<ItemType>::clear()
+{
+	this->rootPtr.reset();
+}
+
+template<class ItemType>
+SearchTreeSnapshot<ItemType> PersistentSearchTree<ItemType>::snapshot() const
+{
+	return SearchTreeSnapshot<ItemType>(this->rootPtr);
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef RING_QUEUE_
+#define RING_QUEUE_
+
+#include "General.h"
+
+using namespace std;
+
+// Queue for breadth-first walks, stored in a ring buffer.
+// Dequeued slots are reused, so the buffer only grows to the widest level seen and a breadth-first walk
+// over n nodes allocates O(log n) times. clear() keeps the buffer for the next walk.
+template<class T>
+class RingQueue
+{
+private:
+	vector<T> slots;  // The capacity is 0 or a power of two
+	size_t frontIndex;
+	size_t itemCount;
+
+	void grow()
+	{
+		vector<T> newSlots(slots.empty() ? 16 : 2 * slots.size());
+
+		for (size_t i = 0; i < itemCount; i++)
+			newSlots[i] = slots[(frontIndex + i) & (slots.size() - 1)];
+
+		slots.swap(newSlots);
+		frontIndex = 0;
+	}
+
+public:
+	RingQueue() : frontIndex(0), itemCount(0) {}
+
+	bool isEmpty() const { return itemCount == 0; }
+	size_t getLength() const { return itemCount; }
+
+	void enqueue(const T& newItem)
+	{
+		if (itemCount == slots.size()) grow();
+
+		slots[(frontIndex + itemCount) & (slots.size() - 1)] = newItem;
+		itemCount++;
+	}
+
+	// @pre  The queue is not empty.
+	const T& peekFront() const
+	{
+		return slots[frontIndex];
+	}
+
+	// @pre  The queue is not empty.
+	void dequeue()
+	{
+		frontIndex = (frontIndex + 1) & (slots.size() - 1);
+		itemCount--;
+	}
+
+	void clear()
+	{
+		frontIndex = 0;
+		itemCount = 0;
+	}
+}; // end RingQueue
+
+#endif
@@ -4,32 +4,6 @@
 // Default constructor
 soundtrack::soundtrack() { year_released_data = 0; }
 
-// Copy-Constructor
-soundtrack::soundtrack(const soundtrack &rhs)
-{
-	this->setComposer(rhs.getComposer());
-	this->setTitle(rhs.getTitle());
-	this->setLabel(rhs.getLabel());
-	this->setCatalogNumber(rhs.getCatalogNumber());
-	this->setYearRecorded(rhs.getYearRecorded());
-	this->setYearReleased(rhs.getYearReleased());
-
-} // End constructor (soundtrack(const soundtrack &rhs))
-
-  // Copy-Assignment
-soundtrack& soundtrack::operator = (const soundtrack &rhs)
-{
-	this->setComposer(rhs.getComposer());
-	this->setTitle(rhs.getTitle());
-	this->setLabel(rhs.getLabel());
-	this->setCatalogNumber(rhs.getCatalogNumber());
-	this->setYearRecorded(rhs.getYearRecorded());
-	this->setYearReleased(rhs.getYearReleased());
-
-	return (*this);
-
-} // End Copy-Assignment (operator = (const soundtrack &rhs))
-
   // Check if the soundtrack object is empty
 bool soundtrack::empty() const
 {
@@ -45,7 +19,7 @@ bool soundtrack::empty() const
 
 // Check if the soundtrack is equal to another soundtrack
 // It does not require the program implementation to compare all the values.
-bool soundtrack::operator == (const soundtrack &rhs)
+bool soundtrack::operator == (const soundtrack &rhs) const
 {
 	// However, the comparing soundtrack must not be empty
 	if (rhs.empty()) return false;
@@ -72,56 +46,69 @@ bool soundtrack::operator == (const soundtrack &rhs)
 
 } // End function (operator == (const soundtrack &rhs))
 
+  // Check if the soundtrack sorts before another soundtrack
+bool soundtrack::operator < (const soundtrack &rhs) const
+{
+	if (this->title != rhs.title) return this->title < rhs.title;
+	if (this->composer != rhs.composer) return this->composer < rhs.composer;
+	if (this->label != rhs.label) return this->label < rhs.label;
+	if (this->catalog_number != rhs.catalog_number) return this->catalog_number < rhs.catalog_number;
+	if (this->year_recorded != rhs.year_recorded) return this->year_recorded < rhs.year_recorded;
+
+	return this->year_released_data < rhs.year_released_data;
+
+} // End function (operator < (const soundtrack &rhs))
+
   // getComposer() function
-std::string soundtrack::getComposer() const { return this->composer; }
+const std::string& soundtrack::getComposer() const { return this->composer; }
 
 // getTitle() function
-std::string soundtrack::getTitle() const { return this->title; }
+const std::string& soundtrack::getTitle() const { return this->title; }
 
 // getLabel() function
-std::string soundtrack::getLabel() const { return this->label; }
+const std::string& soundtrack::getLabel() const { return this->label; }
 
 // getCatalogNumber() function
-std::string soundtrack::getCatalogNumber() const { return this->catalog_number; }
+const std::string& soundtrack::getCatalogNumber() const { return this->catalog_number; }
 
 // getYearRecorded() function
-std::string soundtrack::getYearRecorded() const { return this->year_recorded; }
+const std::string& soundtrack::getYearRecorded() const { return this->year_recorded; }
 
 // getYearReleased() function
 int soundtrack::getYearReleased() const { return this->year_released_data; }
 
 // getYearReleased() function
-std::string soundtrack::getYearReleasedString() const { return this->year_released; }
+const std::string& soundtrack::getYearReleasedString() const { return this->year_released; }
 
 // setComposer() function
-void soundtrack::setComposer(const std::string &new_composer) {
-	this->composer = new_composer;
+void soundtrack::setComposer(std::string new_composer) {
+	this->composer = std::move(new_composer);
 }
 
 // setTitle() function
-void soundtrack::setTitle(const std::string &new_title) {
-	this->title = new_title;
+void soundtrack::setTitle(std::string new_title) {
+	this->title = std::move(new_title);
 }
 
 // setLabel() function
-void soundtrack::setLabel(const std::string &new_label) {
-	this->label = new_label;
+void soundtrack::setLabel(std::string new_label) {
+	this->label = std::move(new_label);
 }
 
 // setCatalogNumber() function
-void soundtrack::setCatalogNumber(const std::string &new_catalog_number) {
-	this->catalog_number = new_catalog_number;
+void soundtrack::setCatalogNumber(std::string new_catalog_number) {
+	this->catalog_number = std::move(new_catalog_number);
 }
 
 // setYearRecorded() function
-void soundtrack::setYearRecorded(const std::string &new_year_recorded) {
-	this->year_recorded = new_year_recorded;
+void soundtrack::setYearRecorded(std::string new_year_recorded) {
+	this->year_recorded = std::move(new_year_recorded);
 }
 
 // setYearReleased() function
-void soundtrack::setYearReleased(const std::string &new_year_released) {
-	this->year_released = new_year_released;
+void soundtrack::setYearReleased(std::string new_year_released) {
 	this->year_released_data = atoi(new_year_released.c_str());
+	this->year_released = std::move(new_year_released);
 }
 
 // setYearReleased() function
@@ -133,17 +120,15 @@ void soundtrack::setYearReleased(int _year_released) {
 	this->year_released_data = _year_released;
 }
 
-void soundtrack::extractComponent(const std::string data, std::string &value, int pos, int length)
+void soundtrack::extractComponent(const std::string &data, std::string &value, int pos, int length)
 {
-	int i;
-	std::string sub_data = data.substr(pos, length);
+	if ((size_t)pos > data.size()) throw std::out_of_range("soundtrack::extractComponent : The field starts past the end of the line");
 
-	for (i = sub_data.size() - 1; i >= 0; i--)
-	{
-		if (sub_data[i] != ' ') { i++; break; }
-	}
+	// Trim the trailing spaces in place, then copy the field once
+	size_t end = min(data.size(), (size_t)pos + length);
+	while (end > (size_t)pos && data[end - 1] == ' ') end--;
 
-	value = sub_data.substr(0, i);
+	value.assign(data, pos, end - pos);
 }
 
 // Overloaded operator function for std::istream (soundtrack)
@@ -185,12 +170,12 @@ std::istream &operator >> (std::istream &is, soundtrack &obj)
 	soundtrack::extractComponent(soundtrack_data, year_recorded, year_recorded_pos, year_recorded_length);
 	soundtrack::extractComponent(soundtrack_data, year_released, year_released_pos, year_released_length);
 
-	obj.setComposer(composer);
-	obj.setTitle(title);
-	obj.setLabel(label);
-	obj.setCatalogNumber(catalog_number);
-	obj.setYearRecorded(year_recorded);
-	obj.setYearReleased(year_released);
+	obj.setComposer(std::move(composer));
+	obj.setTitle(std::move(title));
+	obj.setLabel(std::move(label));
+	obj.setCatalogNumber(std::move(catalog_number));
+	obj.setYearRecorded(std::move(year_recorded));
+	obj.setYearReleased(std::move(year_released));
 
 	return is;
 
@@ -18,65 +18,70 @@ class soundtrack
 public:
 
 	// Default constructor
+	// The copy and move operations are the implicit ones : every member copies or moves on its own.
 	soundtrack();
 
-	// Copy-Constructor
-	soundtrack(const soundtrack &rhs);
-
-	// Copy-Assignment
-	soundtrack& operator = (const soundtrack &rhs);
-
 	// Check if the soundtrack object is empty
 	bool empty() const;
 
 	// Check if the soundtrack is equal to another soundtrack
 	// It does not require the program implementation to compare all the values.
-	bool operator == (const soundtrack &rhs);
+	// Note : BinarySearchTree finds entries with operator<, which compares every field, so contains(), getEntry()
+	// and remove() no longer match on the fields left blank in rhs. Use BinarySearchTree::forEachMatching()
+	// for such a wildcard search, or SoundtrackCatalog for indexed lookups by one field.
+	bool operator == (const soundtrack &rhs) const;
+
+	// Check if the soundtrack sorts before another soundtrack
+	// Soundtracks are ordered by title, then composer, label, catalog number, year recorded and year released.
+	bool operator < (const soundtrack &rhs) const;
 
 	// getComposer() function
-	std::string getComposer() const;
+	const std::string& getComposer() const;
 
 	// getTitle() function
-	std::string getTitle() const;
+	const std::string& getTitle() const;
 
 	// getLabel() function
-	std::string getLabel() const;
+	const std::string& getLabel() const;
 
 	// getCatalogNumber() function
-	std::string getCatalogNumber() const;
+	const std::string& getCatalogNumber() const;
 
 	// getYearRecorded() function
-	std::string getYearRecorded() const;
+	const std::string& getYearRecorded() const;
 
 	// getYearReleased() function
 	int getYearReleased() const;
 
 	// getYearReleased() function
-	std::string getYearReleasedString() const;
+	const std::string& getYearReleasedString() const;
+
+	// The setters take their argument by value and move it in, so passing a temporary copies no string.
 
 	// setComposer() function
-	void setComposer(const std::string &new_composer);
+	void setComposer(std::string new_composer);
 
 	// setTitle() function
-	void setTitle(const std::string &new_title);
+	void setTitle(std::string new_title);
 
 	// setLabel() function
-	void setLabel(const std::string &new_label);
+	void setLabel(std::string new_label);
 
 	// setCatalogNumber() function
-	void setCatalogNumber(const std::string &new_catalog_number);
+	void setCatalogNumber(std::string new_catalog_number);
 
 	// setYearRecorded() function
-	void setYearRecorded(const std::string &new_year_recorded);
+	void setYearRecorded(std::string new_year_recorded);
 
 	// setYearReleased() function
-	void setYearReleased(const std::string &new_year_released);
+	void setYearReleased(std::string new_year_released);
 
 	// setYearReleased() function
 	void setYearReleased(int _year_released);
 
 	// extractComponent() function
-	static void extractComponent(const std::string data, std::string &value, int pos, int length);
+	// Copies the field at [pos, pos + length) of data into value, without its trailing spaces.
+	static void extractComponent(const std::string &data, std::string &value, int pos, int length);
 
 }; // End class soundtrack
 
@@ -0,0 +1,150 @@
+#include "SoundtrackCatalog.h"
+
+// Default constructor
+SoundtrackCatalog::SoundtrackCatalog() : recordCount(0) {}
+
+// Check if the catalog holds no record
+bool SoundtrackCatalog::isEmpty() const
+{
+	return (recordCount == 0);
+}
+
+// getNumberOfRecords() function
+int SoundtrackCatalog::getNumberOfRecords() const
+{
+	return recordCount;
+}
+
+// add() function
+const soundtrack& SoundtrackCatalog::add(soundtrack record)
+{
+	soundtrack* recordPtr;
+
+	if (!freeRecords.empty())
+	{
+		recordPtr = freeRecords.back();
+		freeRecords.pop_back();
+		*recordPtr = std::move(record);
+	}
+	else
+	{
+		records.push_back(std::move(record));
+		recordPtr = &records.back();
+	}
+
+	composerIndex.add(CatalogIndexEntry<ComposerField>(recordPtr));
+	titleIndex.add(CatalogIndexEntry<TitleField>(recordPtr));
+	labelIndex.add(CatalogIndexEntry<LabelField>(recordPtr));
+	catalogNumberIndex.add(CatalogIndexEntry<CatalogNumberField>(recordPtr));
+	yearReleasedIndex.add(CatalogIndexEntry<YearReleasedField>(recordPtr));
+
+	recordCount++;
+	return *recordPtr;
+} // End add()
+
+// remove() function
+bool SoundtrackCatalog::remove(const soundtrack& record)
+{
+	soundtrack* recordPtr = findRecord(record);
+	if (recordPtr == nullptr) return false;
+
+	// The entries are found through the record, so they go before the record is cleared
+	composerIndex.remove(CatalogIndexEntry<ComposerField>(recordPtr));
+	titleIndex.remove(CatalogIndexEntry<TitleField>(recordPtr));
+	labelIndex.remove(CatalogIndexEntry<LabelField>(recordPtr));
+	catalogNumberIndex.remove(CatalogIndexEntry<CatalogNumberField>(recordPtr));
+	yearReleasedIndex.remove(CatalogIndexEntry<YearReleasedField>(recordPtr));
+
+	*recordPtr = soundtrack();
+	freeRecords.push_back(recordPtr);
+
+	recordCount--;
+	return true;
+} // End remove()
+
+// clear() function
+void SoundtrackCatalog::clear()
+{
+	composerIndex.clear();
+	titleIndex.clear();
+	labelIndex.clear();
+	catalogNumberIndex.clear();
+	yearReleasedIndex.clear();
+
+	records.clear();
+	freeRecords.clear();
+	recordCount = 0;
+}
+
+// findRecord() function
+soundtrack* SoundtrackCatalog::findRecord(const soundtrack& record) const
+{
+	vector<const soundtrack*> sameTitle;
+	findInRange(titleIndex, record.getTitle(), record.getTitle(), sameTitle);
+
+	for (size_t i = 0; i < sameTitle.size(); i++)
+	{
+		// operator< compares every field
+		if (!(*sameTitle[i] < record) && !(record < *sameTitle[i]))
+			return const_cast<soundtrack*>(sameTitle[i]); // The catalog owns its records; only callers see them const
+	}
+
+	return nullptr;
+} // End findRecord()
+
+// findByComposer() function
+vector<const soundtrack*> SoundtrackCatalog::findByComposer(const std::string& composer) const
+{
+	vector<const soundtrack*> found;
+	findInRange(composerIndex, composer, composer, found);
+
+	return found;
+}
+
+// findByTitle() function
+vector<const soundtrack*> SoundtrackCatalog::findByTitle(const std::string& title) const
+{
+	vector<const soundtrack*> found;
+	findInRange(titleIndex, title, title, found);
+
+	return found;
+}
+
+// findByLabel() function
+vector<const soundtrack*> SoundtrackCatalog::findByLabel(const std::string& label) const
+{
+	vector<const soundtrack*> found;
+	findInRange(labelIndex, label, label, found);
+
+	return found;
+}
+
+// findByCatalogNumber() function
+vector<const soundtrack*> SoundtrackCatalog::findByCatalogNumber(const std::string& catalog_number) const
+{
+	vector<const soundtrack*> found;
+	findInRange(catalogNumberIndex, catalog_number, catalog_number, found);
+
+	return found;
+}
+
+// findByYearReleased() function
+vector<const soundtrack*> SoundtrackCatalog::findByYearReleased(int year_released) const
+{
+	return findByYearReleased(year_released, year_released);
+}
+
+// findByYearReleased() function
+vector<const soundtrack*> SoundtrackCatalog::findByYearReleased(int lowYear, int highYear) const
+{
+	vector<const soundtrack*> found;
+	findInRange(yearReleasedIndex, lowYear, highYear, found);
+
+	return found;
+}
+
+// countByYearReleased() function
+int SoundtrackCatalog::countByYearReleased(int lowYear, int highYear) const
+{
+	return countInRange(yearReleasedIndex, lowYear, highYear);
+}
@@ -0,0 +1,198 @@
+#ifndef SOUNDTRACK_CATALOG_
+#define SOUNDTRACK_CATALOG_
+
+#include "General.h"
+#include "Soundtrack.h"
+#include "BinarySearchTree.h"
+#include <deque>
+
+using namespace std;
+
+// The soundtrack fields the catalog indexes. Each one reads, writes and compares its field.
+struct ComposerField
+{
+	typedef std::string ValueType;
+	static void set(soundtrack& record, const ValueType& value) { record.setComposer(value); }
+	static int compare(const soundtrack& lhs, const soundtrack& rhs) { return lhs.getComposer().compare(rhs.getComposer()); }
+};
+
+struct TitleField
+{
+	typedef std::string ValueType;
+	static void set(soundtrack& record, const ValueType& value) { record.setTitle(value); }
+	static int compare(const soundtrack& lhs, const soundtrack& rhs) { return lhs.getTitle().compare(rhs.getTitle()); }
+};
+
+struct LabelField
+{
+	typedef std::string ValueType;
+	static void set(soundtrack& record, const ValueType& value) { record.setLabel(value); }
+	static int compare(const soundtrack& lhs, const soundtrack& rhs) { return lhs.getLabel().compare(rhs.getLabel()); }
+};
+
+struct CatalogNumberField
+{
+	typedef std::string ValueType;
+	static void set(soundtrack& record, const ValueType& value) { record.setCatalogNumber(value); }
+	static int compare(const soundtrack& lhs, const soundtrack& rhs) { return lhs.getCatalogNumber().compare(rhs.getCatalogNumber()); }
+};
+
+struct YearReleasedField
+{
+	typedef int ValueType;
+	static void set(soundtrack& record, const ValueType& value) { record.setYearReleased(value); }
+	static int compare(const soundtrack& lhs, const soundtrack& rhs)
+	{
+		return (lhs.getYearReleased() < rhs.getYearReleased()) ? -1 : (rhs.getYearReleased() < lhs.getYearReleased()) ? 1 : 0;
+	}
+};
+
+// Entry of a secondary index : a pointer to a record of the catalog, ordered by one field of the record.
+// Records with equal fields are ordered by address, so every entry is unique and can be removed exactly.
+// A probe entry points at a scratch record holding only the field to look for; its rank puts it before
+// (LowProbe) or after (HighProbe) every record with that field, so a range between two probes holds
+// exactly the records whose field lies between the two values.
+template<class Field>
+class CatalogIndexEntry
+{
+private:
+	const soundtrack* recordPtr;
+	int probeRank;
+
+public:
+	static const int LowProbe = -1;
+	static const int Record = 0;
+	static const int HighProbe = 1;
+
+	CatalogIndexEntry() : recordPtr(nullptr), probeRank(Record) {}
+	CatalogIndexEntry(const soundtrack* record, int rank = Record) : recordPtr(record), probeRank(rank) {}
+
+	const soundtrack& getRecord() const { return *recordPtr; }
+
+	bool operator == (const CatalogIndexEntry& rhs) const
+	{
+		return (recordPtr == rhs.recordPtr && probeRank == rhs.probeRank);
+	}
+
+	bool operator < (const CatalogIndexEntry& rhs) const
+	{
+		int fieldOrder = Field::compare(*recordPtr, *rhs.recordPtr);
+		if (fieldOrder != 0) return fieldOrder < 0;
+		if (probeRank != rhs.probeRank) return probeRank < rhs.probeRank;
+
+		return std::less<const soundtrack*>()(recordPtr, rhs.recordPtr);
+	}
+}; // end CatalogIndexEntry
+
+// Collection of soundtrack records that can be looked up by composer, title, label, catalog number or
+// year released in O(log n + k) for k matches.
+// Each record is stored once, in a pool that never moves it, and each index is an AVL tree of pointers to
+// the records (see CatalogIndexEntry), so an index costs one small node per record whatever the record size.
+// Records are read-only once added, since changing a field would break the order of its index :
+// remove the record and add the changed one instead.
+class SoundtrackCatalog
+{
+private:
+	template<class Field>
+	using Index = BinarySearchTree<CatalogIndexEntry<Field>, AvlPolicy>;
+
+	deque<soundtrack> records;       // Grows at the back only, so records keep their address
+	vector<soundtrack*> freeRecords; // Slots of removed records, reused by add()
+	int recordCount;
+
+	Index<ComposerField> composerIndex;
+	Index<TitleField> titleIndex;
+	Index<LabelField> labelIndex;
+	Index<CatalogNumberField> catalogNumberIndex;
+	Index<YearReleasedField> yearReleasedIndex;
+
+	// Appends the records of index whose field lies from low to high, both included, in index order.
+	template<class Field>
+	static void findInRange(const Index<Field>& index, const typename Field::ValueType& low,
+		const typename Field::ValueType& high, vector<const soundtrack*>& found);
+
+	// Returns the number of records of index whose field lies from low to high, both included.
+	template<class Field>
+	static int countInRange(const Index<Field>& index, const typename Field::ValueType& low, const typename Field::ValueType& high);
+
+	// Returns the stored record equal to record in every field, or nullptr.
+	soundtrack* findRecord(const soundtrack& record) const;
+
+public:
+	//------------------------------------------------------------
+	// Constructor and Destructor Section.
+	// Copying a catalog would leave its indexes pointing at the other catalog's records.
+	//------------------------------------------------------------
+	SoundtrackCatalog();
+	SoundtrackCatalog(const SoundtrackCatalog&) = delete;
+	SoundtrackCatalog& operator=(const SoundtrackCatalog&) = delete;
+
+	//------------------------------------------------------------
+	// Public Methods Section.
+	//------------------------------------------------------------
+	bool isEmpty() const;
+	int getNumberOfRecords() const;
+
+	// Stores the record and indexes it. The returned record stays at the same address until it is removed.
+	const soundtrack& add(soundtrack record);
+
+	// Removes one stored record equal to record in every field (the wildcard operator== is not used).
+	// @return  True if such a record was found.
+	bool remove(const soundtrack& record);
+	void clear();
+
+	//------------------------------------------------------------
+	// Lookup Section.
+	// Each returns the matching records, sorted by the field looked up and then in no particular order.
+	//------------------------------------------------------------
+	vector<const soundtrack*> findByComposer(const std::string& composer) const;
+	vector<const soundtrack*> findByTitle(const std::string& title) const;
+	vector<const soundtrack*> findByLabel(const std::string& label) const;
+	vector<const soundtrack*> findByCatalogNumber(const std::string& catalog_number) const;
+	vector<const soundtrack*> findByYearReleased(int year_released) const;
+
+	// Records released from lowYear to highYear, both included.
+	vector<const soundtrack*> findByYearReleased(int lowYear, int highYear) const;
+
+	// Counts the records released from lowYear to highYear, both included, in O(log n).
+	int countByYearReleased(int lowYear, int highYear) const;
+
+	// Calls visit on each record, in title order.
+	template<class Visitor>
+	void forEachByTitle(Visitor visit) const;
+}; // end SoundtrackCatalog
+
+   // -------------------Definitons----------------------------
+template<class Field>
+void SoundtrackCatalog::findInRange(const Index<Field>& index, const typename Field::ValueType& low,
+	const typename Field::ValueType& high, vector<const soundtrack*>& found)
+{
+	soundtrack lowRecord, highRecord;
+	Field::set(lowRecord, low);
+	Field::set(highRecord, high);
+
+	index.forEachInRange(CatalogIndexEntry<Field>(&lowRecord, CatalogIndexEntry<Field>::LowProbe),
+		CatalogIndexEntry<Field>(&highRecord, CatalogIndexEntry<Field>::HighProbe),
+		[&found](const CatalogIndexEntry<Field>& entry) { found.push_back(&entry.getRecord()); });
+}
+
+template<class Field>
+int SoundtrackCatalog::countInRange(const Index<Field>& index, const typename Field::ValueType& low,
+	const typename Field::ValueType& high)
+{
+	soundtrack lowRecord, highRecord;
+	Field::set(lowRecord, low);
+	Field::set(highRecord, high);
+
+	return index.countInRange(CatalogIndexEntry<Field>(&lowRecord, CatalogIndexEntry<Field>::LowProbe),
+		CatalogIndexEntry<Field>(&highRecord, CatalogIndexEntry<Field>::HighProbe));
+}
+
+template<class Visitor>
+void SoundtrackCatalog::forEachByTitle(Visitor visit) const
+{
+	for (auto entryIter = titleIndex.begin(); entryIter != titleIndex.end(); ++entryIter)
+		visit(entryIter->getRecord());
+}
+
+#endif
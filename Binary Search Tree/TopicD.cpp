@@ -53,6 +53,10 @@
 
 // While the height of the original "Binary search tree" is 8. 
 
+// Note : the level-filled shape above is the one kept by BinaryNodeTree.
+// BinarySearchTree orders its entries with operator< (left < node <= right), so add(), contains(),
+// getEntry() and remove() follow a single root-to-leaf path instead of scanning the whole tree.
+
 template<class T>
 void outputPost(T &t);
 
@@ -175,7 +179,7 @@ int main()
 	while (inFile)
 	{
 		// Appends an empty soundtrack element
-		soundtrack_data.push_back(soundtrack());
+		soundtrack_data.emplace_back();
 
 		// Attempt to load data from the file. If the operation fails, remove the element
 		if (!(inFile >> soundtrack_data.back())) soundtrack_data.pop_back();
@@ -184,9 +188,10 @@ int main()
 	inFile.close();
 	BinarySearchTree<soundtrack> bstST1;
 
+	// The parsed soundtracks are not needed afterwards, so their strings move into the tree
 	for (i = 0; i < (int)soundtrack_data.size(); i++)
 	{
-		bstST1.add(soundtrack_data[i]);
+		bstST1.add(std::move(soundtrack_data[i]));
 	}
 
 	cout << "Display bstST1" << endl << endl;
@@ -0,0 +1,57 @@
+#ifndef TRAVERSAL_STACK_
+#define TRAVERSAL_STACK_
+
+#include "General.h"
+
+using namespace std;
+
+// How a traversal walks the tree :
+// + Recursive : one call per node, so the depth of the tree is limited by the call stack.
+// + Iterative : an explicit SmallStack, which only touches the heap for paths deeper than its inline buffer.
+// + Morris : no stack at all. Empty right links are threaded to the inorder successor for the duration of the walk
+//   and restored afterwards, so the tree must not be read by anyone else meanwhile. An early stop, or a visitor
+//   that throws, still walks the rest of the tree, without visiting, to restore the links before returning or
+//   rethrowing. Postorder falls back to Iterative.
+enum class TraversalMode { Recursive, Iterative, Morris };
+
+// Stack for tree walks : the first InlineCapacity entries live inside the object, the rest spill into a vector.
+template<class T, int InlineCapacity = 64>
+class SmallStack
+{
+private:
+	T inlineItems[InlineCapacity];
+	vector<T> overflowItems;
+	int itemCount;
+
+public:
+	SmallStack() : itemCount(0) {}
+
+	bool isEmpty() const { return itemCount == 0; }
+
+	int getSize() const { return itemCount; }
+
+	void push(const T& newItem)
+	{
+		if (itemCount < InlineCapacity)
+			inlineItems[itemCount] = newItem;
+		else
+			overflowItems.push_back(newItem);
+
+		itemCount++;
+	}
+
+	// @pre  The stack is not empty.
+	const T& peek() const
+	{
+		return (itemCount <= InlineCapacity) ? inlineItems[itemCount - 1] : overflowItems.back();
+	}
+
+	// @pre  The stack is not empty.
+	void pop()
+	{
+		if (itemCount > InlineCapacity) overflowItems.pop_back();
+		itemCount--;
+	}
+}; // end SmallStack
+
+#endif
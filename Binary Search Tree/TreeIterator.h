@@ -0,0 +1,190 @@
+#ifndef TREE_ITERATOR_
+#define TREE_ITERATOR_
+
+#include "BinaryNode.h"
+#include "TraversalStack.h"
+#include <iterator>
+#include <cstddef>
+
+using namespace std;
+
+// Bidirectional inorder iterator over the nodes of a binary search tree.
+// Nodes keep no parent pointer, so the iterator carries the path from the root down to its node, in a SmallStack
+// so that creating or copying an iterator does not touch the heap unless the tree is deeper than 64 levels.
+// Dereferencing yields the stored item itself, which stays valid until that entry is removed;
+// adding or removing entries invalidates every iterator of the tree.
+template<class ItemType>
+class TreeIterator
+{
+private:
+	const BinaryUnit* rootPtr;
+	SmallStack<const BinaryUnit*> path; // Root at the bottom, the current node on top; empty past the last entry
+
+	void pushLeftmost(const BinaryUnit* nodePtr)
+	{
+		while (nodePtr != nullptr)
+		{
+			path.push(nodePtr);
+			nodePtr = nodePtr->getLeftChild();
+		}
+	}
+
+	void pushRightmost(const BinaryUnit* nodePtr)
+	{
+		while (nodePtr != nullptr)
+		{
+			path.push(nodePtr);
+			nodePtr = nodePtr->getRightChild();
+		}
+	}
+
+public:
+	typedef std::bidirectional_iterator_tag iterator_category;
+	typedef ItemType value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const ItemType* pointer;
+	typedef const ItemType& reference;
+
+	TreeIterator() : rootPtr(nullptr) {}
+
+	// Starts at the smallest entry of the tree rooted at treePtr, or past the last entry if atEnd is true.
+	TreeIterator(const BinaryUnit* treePtr, bool atEnd) : rootPtr(treePtr)
+	{
+		if (!atEnd) pushLeftmost(treePtr);
+	}
+
+	// Starts at the first entry of the tree rooted at treePtr that is not less than key or, if isStrict,
+	// greater than key; past the last entry if there is none. One walk down the tree, in O(height).
+	TreeIterator(const BinaryUnit* treePtr, const ItemType& key, bool isStrict) : rootPtr(treePtr)
+	{
+		int boundDepth = 0; // Length of the path to the best node so far
+		const BinaryUnit* nodePtr = treePtr;
+
+		while (nodePtr != nullptr)
+		{
+			path.push(nodePtr);
+
+			bool isBeforeBound = isStrict ? !(key < nodePtr->getItem()) : (nodePtr->getItem() < key);
+			if (isBeforeBound)
+			{
+				nodePtr = nodePtr->getRightChild();
+			}
+			else
+			{
+				boundDepth = path.getSize();
+				nodePtr = nodePtr->getLeftChild();
+			}
+		}
+
+		while (path.getSize() > boundDepth) path.pop();
+	}
+
+	// Returns an iterator at the entry of the given position (0 for the smallest) in the tree rooted at treePtr,
+	// or past the last entry if there is no such position. Uses the node counts to walk down one path.
+	static TreeIterator atPosition(const BinaryUnit* treePtr, int position)
+	{
+		TreeIterator result(treePtr, true);
+		if (treePtr == nullptr || position < 0 || position >= treePtr->getNodeCount()) return result;
+
+		const BinaryUnit* nodePtr = treePtr;
+		while (true)
+		{
+			result.path.push(nodePtr);
+
+			const BinaryUnit* leftPtr = nodePtr->getLeftChild();
+			int leftCount = (leftPtr == nullptr) ? 0 : leftPtr->getNodeCount();
+
+			if (position == leftCount) return result;
+
+			if (position < leftCount)
+			{
+				nodePtr = leftPtr;
+			}
+			else
+			{
+				position -= leftCount + 1;
+				nodePtr = nodePtr->getRightChild();
+			}
+		}
+	}
+
+	reference operator*() const { return path.peek()->getItem(); }
+	pointer operator->() const { return &path.peek()->getItem(); }
+
+	TreeIterator& operator++()
+	{
+		const BinaryUnit* nodePtr = path.peek();
+
+		if (nodePtr->getRightChild() != nullptr)
+		{
+			pushLeftmost(nodePtr->getRightChild());
+			return *this;
+		}
+
+		// Climb out of right subtrees : the first ancestor reached from its left side comes next
+		path.pop();
+		while (!path.isEmpty() && path.peek()->getRightChild() == nodePtr)
+		{
+			nodePtr = path.peek();
+			path.pop();
+		}
+
+		return *this;
+	}
+
+	TreeIterator& operator--()
+	{
+		if (path.isEmpty())
+		{
+			pushRightmost(rootPtr);
+			return *this;
+		}
+
+		const BinaryUnit* nodePtr = path.peek();
+
+		if (nodePtr->getLeftChild() != nullptr)
+		{
+			pushRightmost(nodePtr->getLeftChild());
+			return *this;
+		}
+
+		// Climb out of left subtrees : the first ancestor reached from its right side comes before
+		path.pop();
+		while (!path.isEmpty() && path.peek()->getLeftChild() == nodePtr)
+		{
+			nodePtr = path.peek();
+			path.pop();
+		}
+
+		return *this;
+	}
+
+	TreeIterator operator++(int)
+	{
+		TreeIterator previous(*this);
+		++(*this);
+		return previous;
+	}
+
+	TreeIterator operator--(int)
+	{
+		TreeIterator previous(*this);
+		--(*this);
+		return previous;
+	}
+
+	bool operator==(const TreeIterator& other) const
+	{
+		const BinaryUnit* nodePtr = path.isEmpty() ? nullptr : path.peek();
+		const BinaryUnit* otherNodePtr = other.path.isEmpty() ? nullptr : other.path.peek();
+
+		return (nodePtr == otherNodePtr && rootPtr == other.rootPtr);
+	}
+
+	bool operator!=(const TreeIterator& other) const
+	{
+		return !(*this == other);
+	}
+}; // end TreeIterator
+
+#endif
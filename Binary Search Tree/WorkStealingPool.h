@@ -0,0 +1,241 @@
+#ifndef WORK_STEALING_POOL_
+#define WORK_STEALING_POOL_
+
+#include "General.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <functional>
+#include <exception>
+
+using namespace std;
+
+// Fixed set of worker threads for fork-join work.
+// Each worker has its own queue : it runs its newest task first, which keeps the data it just split in cache,
+// and an idle worker steals the oldest task of another queue, which tends to be the largest piece of work left.
+// Tasks submitted from outside the pool go to a shared queue that every worker steals from.
+// A thread waiting on a TaskGroup runs queued tasks meanwhile, its own first, so nested groups cannot starve the pool.
+class WorkStealingPool
+{
+private:
+	struct TaskQueue
+	{
+		std::mutex queueMutex;
+		deque<std::function<void()> > tasks;
+	};
+
+	// The pool and the queue of the calling thread, if it is one of the workers, and how many stolen tasks
+	// the thread is running inside one another.
+	struct WorkerIdentity
+	{
+		WorkStealingPool* poolPtr;
+		int queueIndex;
+		int stealDepth;
+	};
+
+	// A waiting thread stops stealing past this many nested stolen tasks, which bounds its stack. It does not
+	// need to steal to make progress : the tasks it waits for are in its own queue or running on other threads.
+	static const int maxStealDepth = 8;
+
+	vector<std::unique_ptr<TaskQueue> > queues; // One per worker, then the shared queue
+	vector<std::thread> workers;
+	std::atomic<bool> isStopping;
+	std::atomic<int> queuedCount;
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+
+	static WorkerIdentity& currentWorker()
+	{
+		static thread_local WorkerIdentity identity = { nullptr, -1, 0 };
+		return identity;
+	}
+
+	// The queue the calling thread pushes to and works from : its own for a worker, or else the shared queue.
+	int getHomeIndex()
+	{
+		WorkerIdentity& identity = currentWorker();
+		return (identity.poolPtr == this) ? identity.queueIndex : (int)workers.size();
+	}
+
+	void submit(std::function<void()> task)
+	{
+		int queueIndex = getHomeIndex();
+
+		{
+			std::lock_guard<std::mutex> lock(queues[queueIndex]->queueMutex);
+			queues[queueIndex]->tasks.push_back(std::move(task));
+		}
+		queuedCount.fetch_add(1);
+
+		// Taking the lock orders this with a worker that is about to sleep, so the wake-up is not lost
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		wakeUp.notify_one();
+	}
+
+	// Runs one queued task : the newest of the caller's home queue or, if canSteal, the oldest of another queue.
+	// Returns false if there was none.
+	bool tryRunTask(bool canSteal)
+	{
+		std::function<void()> task;
+		int homeIndex = getHomeIndex();
+		int queueTotal = (int)queues.size();
+
+		{
+			std::lock_guard<std::mutex> lock(queues[homeIndex]->queueMutex);
+			if (!queues[homeIndex]->tasks.empty())
+			{
+				task = std::move(queues[homeIndex]->tasks.back());
+				queues[homeIndex]->tasks.pop_back();
+			}
+		}
+
+		bool isStolen = false;
+		for (int i = 1; canSteal && !task && i < queueTotal; i++)
+		{
+			TaskQueue& victim = *queues[(homeIndex + i) % queueTotal];
+			std::lock_guard<std::mutex> lock(victim.queueMutex);
+
+			if (!victim.tasks.empty())
+			{
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				isStolen = true;
+			}
+		}
+
+		if (!task) return false;
+
+		queuedCount.fetch_sub(1);
+
+		// Tasks do not throw : TaskGroup::run catches what they throw
+		WorkerIdentity& identity = currentWorker();
+		if (isStolen) identity.stealDepth++;
+		task();
+		if (isStolen) identity.stealDepth--;
+
+		return true;
+	}
+
+	// Runs queued tasks for a thread that waits on a TaskGroup, or yields if it may not run any.
+	void helpWhileWaiting()
+	{
+		if (!tryRunTask(currentWorker().stealDepth < maxStealDepth)) std::this_thread::yield();
+	}
+
+	void workerLoop(int queueIndex)
+	{
+		currentWorker().poolPtr = this;
+		currentWorker().queueIndex = queueIndex;
+
+		while (!isStopping.load())
+		{
+			if (tryRunTask(true)) continue;
+
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			wakeUp.wait(lock, [this]() { return isStopping.load() || queuedCount.load() > 0; });
+		}
+	}
+
+public:
+	// A set of tasks that can be waited for together.
+	class TaskGroup
+	{
+	private:
+		WorkStealingPool& pool;
+		std::atomic<int> pendingCount;
+		std::mutex errorMutex;
+		std::exception_ptr firstError;
+
+	public:
+		explicit TaskGroup(WorkStealingPool& taskPool) : pool(taskPool), pendingCount(0) {}
+
+		~TaskGroup()
+		{
+			while (pendingCount.load() > 0)
+				pool.helpWhileWaiting();
+		}
+
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		// Queues task, a callable taking no argument.
+		template<class Task>
+		void run(Task task)
+		{
+			pendingCount.fetch_add(1);
+
+			pool.submit([this, task]() mutable
+			{
+				try
+				{
+					task();
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(errorMutex);
+					if (!firstError) firstError = std::current_exception();
+				}
+
+				pendingCount.fetch_sub(1); // The group may be gone once this reaches zero
+			});
+		}
+
+		// Runs queued tasks until every task of the group has finished, then rethrows the first exception one threw.
+		void wait()
+		{
+			while (pendingCount.load() > 0)
+				pool.helpWhileWaiting();
+
+			if (firstError)
+			{
+				std::exception_ptr error = firstError;
+				firstError = nullptr;
+				std::rethrow_exception(error);
+			}
+		}
+	}; // end TaskGroup
+
+	// Starts threadCount workers, or one less than the number of hardware threads if threadCount is 0
+	// (the thread that waits on a group works too).
+	explicit WorkStealingPool(int threadCount = 0) : isStopping(false), queuedCount(0)
+	{
+		if (threadCount <= 0) threadCount = max(1, (int)std::thread::hardware_concurrency() - 1);
+
+		for (int i = 0; i <= threadCount; i++)
+			queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+
+		for (int i = 0; i < threadCount; i++)
+			workers.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+	}
+
+	// @pre  No TaskGroup of the pool is still running.
+	~WorkStealingPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			isStopping.store(true);
+		}
+		wakeUp.notify_all();
+
+		for (size_t i = 0; i < workers.size(); i++)
+			workers[i].join();
+	}
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	int getThreadCount() const { return (int)workers.size(); }
+
+	// The pool the parallel tree operations use unless they are given one.
+	static WorkStealingPool& getDefault()
+	{
+		static WorkStealingPool pool;
+		return pool;
+	}
+}; // end WorkStealingPool
+
+#endif